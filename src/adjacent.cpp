@@ -7,13 +7,12 @@ namespace snake
     Surroundings::Surroundings(const BoardPos_t & centerPos)
         : center_pos(centerPos)
         , adjacents()
-    {
-        adjacents.reserve(4);
-    }
+        , adjacent_count(0)
+    {}
 
     PieceEnumOpt_t Surroundings::pieceInDirOpt(const sf::Keyboard::Key dirToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (dirToFind == ap.dir)
             {
@@ -26,7 +25,7 @@ namespace snake
 
     BoardPosOpt_t Surroundings::posInDirOpt(const sf::Keyboard::Key dirToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (dirToFind == ap.dir)
             {
@@ -39,7 +38,7 @@ namespace snake
 
     BoardPos_t Surroundings::posInDir(const sf::Keyboard::Key dirToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (dirToFind == ap.dir)
             {
@@ -52,7 +51,7 @@ namespace snake
 
     DirKeyOpt_t Surroundings::dirOfPieceOpt(const Piece pieceToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (pieceToFind == ap.piece)
             {
@@ -65,7 +64,7 @@ namespace snake
 
     sf::Keyboard::Key Surroundings::dirOfPiece(const Piece pieceToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (pieceToFind == ap.piece)
             {
@@ -78,7 +77,7 @@ namespace snake
 
     BoardPosOpt_t Surroundings::posOfPieceOpt(const Piece pieceToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (pieceToFind == ap.piece)
             {
@@ -91,7 +90,7 @@ namespace snake
 
     BoardPos_t Surroundings::posOfPiece(const Piece pieceToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (pieceToFind == ap.piece)
             {
@@ -104,7 +103,7 @@ namespace snake
 
     PieceEnumOpt_t Surroundings::pieceAtPosOpt(const BoardPos_t & posToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (posToFind == ap.pos)
             {
@@ -117,7 +116,7 @@ namespace snake
 
     DirKeyOpt_t Surroundings::dirOfPosOpt(const BoardPos_t & posToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (posToFind == ap.pos)
             {
@@ -130,7 +129,7 @@ namespace snake
 
     sf::Keyboard::Key Surroundings::dirOfPos(const BoardPos_t & posToFind) const
     {
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (posToFind == ap.pos)
             {
@@ -144,7 +143,7 @@ namespace snake
     std::size_t Surroundings::pieceCount(const Piece pieceToFind) const
     {
         std::size_t count{ 0 };
-        for (const AdjacentInfo & ap : adjacents)
+        for (const AdjacentInfo & ap : *this)
         {
             if (pieceToFind == ap.piece)
             {
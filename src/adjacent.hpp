@@ -7,10 +7,11 @@
 #include "keys.hpp"
 #include "pieces.hpp"
 
+#include <array>
+#include <cstddef>
 #include <initializer_list>
 #include <optional>
 #include <tuple>
-#include <vector>
 
 //
 
@@ -49,10 +50,17 @@ namespace snake
 
     //
 
+    // Only the occupied cells of the four around center_pos, see Board::surroundings().  Fixed
+    // size so that making one never allocates, and only the first adjacent_count are valid.
     struct Surroundings
     {
         explicit Surroundings(const BoardPos_t & centerPos);
 
+        void add(const AdjacentInfo & info) { adjacents[adjacent_count++] = info; }
+
+        const AdjacentInfo * begin() const { return adjacents.data(); }
+        const AdjacentInfo * end() const { return (adjacents.data() + adjacent_count); }
+
         PieceEnumOpt_t pieceInDirOpt(const sf::Keyboard::Key dirToFind) const;
         BoardPosOpt_t posInDirOpt(const sf::Keyboard::Key dirToFind) const;
         BoardPos_t posInDir(const sf::Keyboard::Key dirToFind) const;
@@ -70,7 +78,8 @@ namespace snake
         std::size_t piecesCount(const std::initializer_list<Piece> & list) const;
 
         BoardPos_t center_pos{ BoardPosInvalid };
-        std::vector<AdjacentInfo> adjacents;
+        std::array<AdjacentInfo, 4> adjacents;
+        std::size_t adjacent_count{ 0 };
     };
 
 } // namespace snake
@@ -0,0 +1,323 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// batch-simulator.cpp
+//
+#include "batch-simulator.hpp"
+
+#include "check-macros.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace snake
+{
+    BatchWorld::BatchWorld(const GameConfig & config, const Layout & layout)
+        : m_game()
+        , m_board()
+        , m_random(0)
+        , m_state()
+        , m_observer()
+        , m_context(config, layout, m_game, m_board, m_random, m_state, m_observer)
+        , m_seed(0)
+        , m_isTimedOut(false)
+    {}
+
+    BatchGameResult BatchWorld::play(const std::size_t gameIndex, const Seed_t seed)
+    {
+        start(seed);
+
+        while (tick())
+        {
+        }
+
+        return result(gameIndex);
+    }
+
+    void BatchWorld::start(const Seed_t seed)
+    {
+        // Which free cell gets picked at random depends on the order the Board keeps them in,
+        // which depends on every game played before, so the Board has to start over too.
+        m_seed = seed;
+        m_random.reseed(seed);
+        m_board.reset(m_context.layout);
+        m_state.reset();
+        m_observer.turn_count = 0;
+        m_observer.life_lost_count = 0;
+        m_context.sim_tick_count = 0;
+        m_context.input_tick = 0;
+        m_context.input_dropped_count = 0;
+        m_context.input_coalesced_count = 0;
+        m_isTimedOut = false;
+
+        m_game.start(m_context);
+    }
+
+    bool BatchWorld::tick()
+    {
+        const std::size_t tickLimit{ m_context.config.headless_tick_limit };
+
+        // nobody is watching the ticks in between, so only the ones where something happens
+        // are played one at a time
+        if (m_context.sim_tick_count < tickLimit)
+        {
+            m_game.skipIdleTicks(m_context, (tickLimit - m_context.sim_tick_count));
+        }
+
+        if (m_context.sim_tick_count >= tickLimit)
+        {
+            m_isTimedOut = true;
+            return false;
+        }
+
+        m_game.tick(m_context);
+
+        return (!m_state.isChangePending() || handleChangePending());
+    }
+
+    void BatchWorld::handleKey(const sf::Keyboard::Key key)
+    {
+        sf::Event event;
+        event.type = sf::Event::KeyPressed;
+        event.key = { key, false, false, false, false };
+
+        m_context.input_tick = m_context.sim_tick_count;
+        m_board.passEventToPieces(m_context, event);
+    }
+
+    BatchGameResult BatchWorld::result(const std::size_t gameIndex) const
+    {
+        BatchGameResult result;
+        result.game_index = gameIndex;
+        result.seed = m_seed;
+        result.score = m_game.score();
+        result.level_reached = m_game.level().number;
+        result.tick_count = m_context.sim_tick_count;
+        result.turn_count = m_observer.turn_count;
+        result.is_timed_out = m_isTimedOut;
+        return result;
+    }
+
+    std::size_t BatchWorld::playerCellIndex() const
+    {
+        const HeadPiece * const playerPtr{ m_board.headPieces().find(m_board.playerHandle()) };
+        if (nullptr == playerPtr)
+        {
+            return m_context.layout.cell_count_total_st;
+        }
+
+        return m_context.layout.cellIndex(playerPtr->position());
+    }
+
+    bool BatchWorld::handleChangePending()
+    {
+        const StateOpt_t changeOpt{ m_state.getChangePending() };
+        m_state.reset();
+
+        // the same as LevelCompleteMessageState::onExit() and GameOverState::onExit()
+        if (State::LevelCompleteMsg == changeOpt)
+        {
+            m_game.setupNextLevel(m_context, true);
+        }
+        else if (State::Over == changeOpt)
+        {
+            if (m_game.lives() == 0)
+            {
+                return false;
+            }
+
+            m_game.setupNextLevel(m_context, false);
+        }
+
+        return true;
+    }
+
+    //
+
+    BatchSimulator::BatchSimulator(const GameConfig & config)
+        : m_config(config)
+        , m_layout()
+        , m_queues()
+        , m_results()
+        , m_threadCount(0)
+        , m_runTimeSec(0.0)
+        , m_exceptionMutex()
+        , m_exceptionPtr()
+    {
+        // nobody is watching, so the AI has to play
+        m_config.is_headless = true;
+        m_config.will_ai_drive_player = true;
+
+        M_CHECK_SS((m_config.sim_ticks_per_sec > 0), m_config.sim_ticks_per_sec);
+        M_CHECK_SS((m_config.headless_tick_limit > 0), m_config.headless_tick_limit);
+
+        if ((0 == m_config.resolution.x) || (0 == m_config.resolution.y))
+        {
+            m_config.resolution = m_defaultResolution;
+        }
+
+        m_layout.reset(m_config);
+    }
+
+    void BatchSimulator::run(
+        const std::size_t gameCount, const std::size_t threadCount, const Seed_t baseSeed)
+    {
+        m_threadCount = threadCount;
+        if (0 == m_threadCount)
+        {
+            m_threadCount = std::max(1_st, std::size_t{ std::thread::hardware_concurrency() });
+        }
+
+        m_threadCount = std::clamp(m_threadCount, 1_st, std::max(1_st, gameCount));
+
+        m_results.clear();
+        m_results.resize(gameCount);
+        m_exceptionPtr = nullptr;
+
+        // each thread starts with an equal run of games
+        m_queues = std::vector<BatchGameQueue>(m_threadCount);
+        for (std::size_t gameIndex(0); gameIndex < gameCount; ++gameIndex)
+        {
+            m_queues.at((gameIndex * m_threadCount) / gameCount).game_indexes.push_back(gameIndex);
+        }
+
+        const auto startTime{ std::chrono::steady_clock::now() };
+
+        std::vector<std::thread> threads;
+        threads.reserve(m_threadCount);
+        for (std::size_t threadIndex(0); threadIndex < m_threadCount; ++threadIndex)
+        {
+            threads.emplace_back(&BatchSimulator::playQueuedGames, this, threadIndex, baseSeed);
+        }
+
+        for (std::thread & thread : threads)
+        {
+            thread.join();
+        }
+
+        const std::chrono::duration<double> runTime{ std::chrono::steady_clock::now() -
+                                                     startTime };
+
+        m_runTimeSec = runTime.count();
+        m_queues.clear();
+
+        if (m_exceptionPtr)
+        {
+            std::rethrow_exception(m_exceptionPtr);
+        }
+    }
+
+    void BatchSimulator::playQueuedGames(const std::size_t threadIndex, const Seed_t baseSeed)
+    {
+        try
+        {
+            BatchWorld world(m_config, m_layout);
+
+            std::size_t gameIndex{ 0 };
+            while (takeGame(threadIndex, gameIndex))
+            {
+                // each result is only ever written by the one thread that took its game
+                m_results[gameIndex] =
+                    world.play(gameIndex, (baseSeed + static_cast<Seed_t>(gameIndex)));
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_exceptionMutex);
+
+            if (!m_exceptionPtr)
+            {
+                m_exceptionPtr = std::current_exception();
+            }
+
+            // stop everyone else from starting another game
+            for (BatchGameQueue & queue : m_queues)
+            {
+                std::lock_guard<std::mutex> queueLock(queue.mutex);
+                queue.game_indexes.clear();
+            }
+        }
+    }
+
+    bool BatchSimulator::takeGame(const std::size_t threadIndex, std::size_t & gameIndex)
+    {
+        {
+            BatchGameQueue & ownQueue{ m_queues[threadIndex] };
+            std::lock_guard<std::mutex> lock(ownQueue.mutex);
+
+            if (!ownQueue.game_indexes.empty())
+            {
+                gameIndex = ownQueue.game_indexes.front();
+                ownQueue.game_indexes.pop_front();
+                return true;
+            }
+        }
+
+        // no games are ever added once started, so if every queue is empty then all are taken
+        for (std::size_t offset(1); offset < m_threadCount; ++offset)
+        {
+            BatchGameQueue & otherQueue{ m_queues[(threadIndex + offset) % m_threadCount] };
+            std::lock_guard<std::mutex> lock(otherQueue.mutex);
+
+            if (!otherQueue.game_indexes.empty())
+            {
+                gameIndex = otherQueue.game_indexes.back();
+                otherQueue.game_indexes.pop_back();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void BatchSimulator::printResults() const
+    {
+        for (const BatchGameResult & result : m_results)
+        {
+            std::cout << "Game #" << result.game_index << " seed=" << result.seed
+                      << " score=" << result.score << " level=" << result.level_reached
+                      << " ticks=" << result.tick_count << " turns=" << result.turn_count
+                      << ((result.is_timed_out) ? " (timed out)" : "") << '\n';
+        }
+    }
+
+    void BatchSimulator::printSummary() const
+    {
+        const double runTimeSec{ std::max(0.001, m_runTimeSec) };
+
+        std::size_t timedOutCount{ 0 };
+        std::size_t tickCount{ 0 };
+        std::size_t turnCount{ 0 };
+        std::size_t levelSum{ 0 };
+        long long scoreSum{ 0 };
+        int scoreMax{ 0 };
+        for (const BatchGameResult & result : m_results)
+        {
+            timedOutCount += ((result.is_timed_out) ? 1 : 0);
+            tickCount += result.tick_count;
+            turnCount += result.turn_count;
+            levelSum += result.level_reached;
+            scoreSum += result.score;
+            scoreMax = std::max(scoreMax, result.score);
+        }
+
+        const double gameCount{ static_cast<double>(std::max(1_st, m_results.size())) };
+
+        std::cout << "Batch Games: " << m_results.size() << " on " << m_threadCount
+                  << " threads (" << timedOutCount << " timed out)\n";
+
+        std::cout << "Score Avg/Max: " << (static_cast<double>(scoreSum) / gameCount) << '/'
+                  << scoreMax << '\n';
+
+        std::cout << "Level Avg: " << (static_cast<double>(levelSum) / gameCount) << '\n';
+        std::cout << "Run Time: " << runTimeSec << "sec\n";
+        std::cout << "Games/Min: " << ((gameCount * 60.0) / runTimeSec) << '\n';
+        std::cout << "Ticks/Sec: " << (static_cast<double>(tickCount) / runTimeSec) << '\n';
+
+        std::cout << "Turns/Sec: " << (static_cast<double>(turnCount) / runTimeSec)
+                  << std::endl;
+    }
+} // namespace snake
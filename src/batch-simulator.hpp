@@ -0,0 +1,191 @@
+#ifndef SNAKE_BATCH_SIMULATOR_HPP_INCLUDED
+#define SNAKE_BATCH_SIMULATOR_HPP_INCLUDED
+//
+// batch-simulator.hpp
+//
+#include "board-history.hpp"
+#include "board.hpp"
+#include "context.hpp"
+#include "game-observer.hpp"
+#include "layout.hpp"
+#include "random.hpp"
+#include "settings.hpp"
+#include "states-pending.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace snake
+{
+    // one game played by the BatchSimulator
+    struct BatchGameResult
+    {
+        std::size_t game_index{ 0 };
+        Seed_t seed{ 0 };
+        int score{ 0 };
+        std::size_t level_reached{ 0 };
+        std::size_t tick_count{ 0 };
+
+        // every time any head moved, so rival turns count too
+        std::size_t turn_count{ 0 };
+
+        bool is_timed_out{ false };
+    };
+
+    //
+
+    // ignores everything but head moves and the player's deaths, which it counts
+    struct CountingObserver final : public IGameObserver
+    {
+        void onBoardCleared() override {}
+
+        void onCellChanged(
+            const std::size_t,
+            const PieceEnumOpt_t &,
+            const PieceEnumOpt_t &,
+            const util::SlotHandle &) override
+        {}
+
+        void onPieceMoved(const std::size_t, const std::size_t) override { ++turn_count; }
+        void onPlayerTailChanged() override {}
+        void onBoardRestored() override {}
+        void onLevelStarted(const std::size_t) override {}
+        void onInputQueued(const sf::Keyboard::Key) override {}
+        void onFoodMissed(const BoardPos_t &) override {}
+        void onFoodEaten(const BoardPos_t &, const int, const bool) override {}
+        void onSlowEaten(const BoardPos_t &) override {}
+        void onShrinkEaten(const BoardPos_t &) override {}
+        void onLifeLost(const Piece) override { ++life_lost_count; }
+        void onGameStatusChanged() override {}
+
+        std::size_t turn_count{ 0 };
+
+        // still counts in god mode, where GameInPlay::lives() never goes down
+        std::size_t life_lost_count{ 0 };
+    };
+
+    //
+
+    // Everything one game changes while it is played, so each thread of the BatchSimulator has
+    // one and re-uses it for every game it plays, and so does each environment of a VectorEnv.
+    class BatchWorld
+    {
+      public:
+        BatchWorld(const GameConfig & config, const Layout & layout);
+
+        // prevent all copy and assignment
+        BatchWorld(const BatchWorld &) = delete;
+        BatchWorld(BatchWorld &&) = delete;
+        //
+        BatchWorld & operator=(const BatchWorld &) = delete;
+        BatchWorld & operator=(BatchWorld &&) = delete;
+
+        // Plays one whole game the same way the GameCoordinator does when headless, except
+        // without a StateMachine, the messages between levels are skipped instead of waited on.
+        BatchGameResult play(const std::size_t gameIndex, const Seed_t seed);
+
+        // starts a new game as if no other had ever been played
+        void start(const Seed_t seed);
+
+        // One tick of play, then whatever state change that tick asked for (the next level or
+        // the same one again after losing a life).  Returns false once the game is over or has
+        // run for headless_tick_limit ticks.
+        bool tick();
+
+        // the same as a key pressed during the current tick, see HeadPiece::handleEvent()
+        void handleKey(const sf::Keyboard::Key key);
+
+        BatchGameResult result(const std::size_t gameIndex) const;
+
+        const Context & context() const { return m_context; }
+        const Board & board() const { return m_board; }
+        const GameInPlay & game() const { return m_game; }
+
+        // every time the player died since start(), god mode or not
+        std::size_t lifeLostCount() const { return m_observer.life_lost_count; }
+
+        // only puts the Board back, see BoardHistory::rewind()
+        bool rewind(BoardHistory & history, const std::size_t stepsBack)
+        {
+            return history.rewind(m_context, m_board, stepsBack);
+        }
+
+        // returns m_context.layout.cell_count_total_st if there is no player
+        std::size_t playerCellIndex() const;
+
+      private:
+        // returns false once the game is over
+        bool handleChangePending();
+
+      private:
+        GameInPlay m_game;
+        Board m_board;
+        util::Random m_random;
+        StatesPending m_state;
+        CountingObserver m_observer;
+        Context m_context;
+        Seed_t m_seed;
+        bool m_isTimedOut;
+    };
+
+    //
+
+    // The games one thread has yet to play.  The owner takes from the front and any thread that
+    // runs out takes from the back, so the threads stay busy no matter how long games last.
+    // Aligned so that no two queues (and their mutexes) share a cache line.
+    struct alignas(64) BatchGameQueue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> game_indexes;
+    };
+
+    //
+
+    // Plays gameCount whole games with the AI driving, spread across threadCount threads, with
+    // no window, sound, or GameCoordinator.  Each thread owns a BatchWorld, and only the
+    // GameConfig and Layout (which never change during play) are shared, so the threads never
+    // wait on each other except to take the next game.  Game N is always seeded with
+    // baseSeed + N, so any one game can be played again on its own.
+    class BatchSimulator
+    {
+      public:
+        explicit BatchSimulator(const GameConfig & config);
+
+        // zero threads means one per core
+        void run(const std::size_t gameCount, const std::size_t threadCount, const Seed_t baseSeed);
+
+        // in game index order no matter which thread played them
+        const std::vector<BatchGameResult> & results() const { return m_results; }
+
+        std::size_t threadCount() const { return m_threadCount; }
+        double runTimeSec() const { return m_runTimeSec; }
+
+        void printResults() const;
+        void printSummary() const;
+
+      private:
+        void playQueuedGames(const std::size_t threadIndex, const Seed_t baseSeed);
+
+        // own queue first, then steals from the others, returns false when all are empty
+        bool takeGame(const std::size_t threadIndex, std::size_t & gameIndex);
+
+      private:
+        GameConfig m_config;
+        Layout m_layout;
+        std::vector<BatchGameQueue> m_queues;
+        std::vector<BatchGameResult> m_results;
+        std::size_t m_threadCount;
+        double m_runTimeSec;
+
+        // the first exception thrown by any thread, which run() throws again once all have ended
+        std::mutex m_exceptionMutex;
+        std::exception_ptr m_exceptionPtr;
+
+        static inline const sf::Vector2u m_defaultResolution{ 1920u, 1080u };
+    };
+} // namespace snake
+
+#endif // SNAKE_BATCH_SIMULATOR_HPP_INCLUDED
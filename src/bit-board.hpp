@@ -0,0 +1,261 @@
+#ifndef BIT_BOARD_HPP_INCLUDED
+#define BIT_BOARD_HPP_INCLUDED
+//
+// bit-board.hpp
+//
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util
+{
+    // One bit per board cell, packed 64 to a word so that counting and combining whole boards
+    // costs one operation per word instead of one per cell.  Bits past size() in the last word
+    // are always kept zero so count() and the bitwise operators never have to mask them off.
+    class BitBoard
+    {
+      public:
+        using Word_t = std::uint64_t;
+
+        static inline const std::size_t bits_per_word{ 64 };
+
+        BitBoard() = default;
+
+        explicit BitBoard(const std::size_t bitCount) { resize(bitCount); }
+
+        // all bits end up cleared
+        void resize(const std::size_t bitCount)
+        {
+            m_bitCount = bitCount;
+            m_words.assign(((bitCount + bits_per_word - 1) / bits_per_word), 0);
+        }
+
+        std::size_t size() const { return m_bitCount; }
+
+        const std::vector<Word_t> & words() const { return m_words; }
+        std::vector<Word_t> & words() { return m_words; }
+
+        bool test(const std::size_t index) const
+        {
+            return ((m_words[index / bits_per_word] & bitMask(index)) != 0);
+        }
+
+        void set(const std::size_t index) { m_words[index / bits_per_word] |= bitMask(index); }
+        void clear(const std::size_t index) { m_words[index / bits_per_word] &= ~bitMask(index); }
+        void clearAll() { std::fill(std::begin(m_words), std::end(m_words), Word_t(0)); }
+
+        // one popCount() per word, which is only a single instruction if the compiler is told
+        // the CPU has one (such as with -mpopcnt), otherwise it is a short library call
+        std::size_t count() const
+        {
+            std::size_t total{ 0 };
+            for (const Word_t word : m_words)
+            {
+                total += popCount(word);
+            }
+
+            return total;
+        }
+
+        bool any() const
+        {
+            return std::any_of(std::begin(m_words), std::end(m_words), [](const Word_t word) {
+                return (word != 0);
+            });
+        }
+
+        bool none() const { return !any(); }
+
+        // calls func(index) for every set bit in increasing order, skipping empty words at once
+        template <typename Func_t>
+        void forEachSetBit(Func_t func) const
+        {
+            for (std::size_t wordIndex(0); wordIndex < m_words.size(); ++wordIndex)
+            {
+                Word_t word{ m_words[wordIndex] };
+                while (word != 0)
+                {
+                    func((wordIndex * bits_per_word) + lowestSetBit(word));
+                    word &= (word - 1);
+                }
+            }
+        }
+
+        // both must be the same size
+        BitBoard & operator|=(const BitBoard & other)
+        {
+            for (std::size_t i(0); i < m_words.size(); ++i)
+            {
+                m_words[i] |= other.m_words[i];
+            }
+
+            return *this;
+        }
+
+        BitBoard & operator&=(const BitBoard & other)
+        {
+            for (std::size_t i(0); i < m_words.size(); ++i)
+            {
+                m_words[i] &= other.m_words[i];
+            }
+
+            return *this;
+        }
+
+        // removes every bit that is set in other
+        BitBoard & andNot(const BitBoard & other)
+        {
+            for (std::size_t i(0); i < m_words.size(); ++i)
+            {
+                m_words[i] &= ~other.m_words[i];
+            }
+
+            return *this;
+        }
+
+        // like std::bitset, moves every bit to a higher index and drops whatever falls off
+        BitBoard & operator<<=(const std::size_t shiftCount)
+        {
+            const std::size_t wordShift{ shiftCount / bits_per_word };
+            const std::size_t bitShift{ shiftCount % bits_per_word };
+
+            for (std::size_t i(m_words.size()); i-- > 0;)
+            {
+                Word_t word{ 0 };
+
+                if (i >= wordShift)
+                {
+                    word = (m_words[i - wordShift] << bitShift);
+
+                    if ((bitShift > 0) && (i > wordShift))
+                    {
+                        word |= (m_words[i - wordShift - 1] >> (bits_per_word - bitShift));
+                    }
+                }
+
+                m_words[i] = word;
+            }
+
+            clearUnusedBits();
+            return *this;
+        }
+
+        // like std::bitset, moves every bit to a lower index and drops whatever falls off
+        BitBoard & operator>>=(const std::size_t shiftCount)
+        {
+            const std::size_t wordShift{ shiftCount / bits_per_word };
+            const std::size_t bitShift{ shiftCount % bits_per_word };
+
+            for (std::size_t i(0); i < m_words.size(); ++i)
+            {
+                Word_t word{ 0 };
+
+                if ((i + wordShift) < m_words.size())
+                {
+                    word = (m_words[i + wordShift] >> bitShift);
+
+                    if ((bitShift > 0) && ((i + wordShift + 1) < m_words.size()))
+                    {
+                        word |= (m_words[i + wordShift + 1] << (bits_per_word - bitShift));
+                    }
+                }
+
+                m_words[i] = word;
+            }
+
+            return *this;
+        }
+
+        // flips every bit, but keeps the unused bits of the last word zero
+        void invert()
+        {
+            for (Word_t & word : m_words)
+            {
+                word = ~word;
+            }
+
+            clearUnusedBits();
+        }
+
+        // counts what is set in both without building a temporary
+        std::size_t countIntersection(const BitBoard & other) const
+        {
+            std::size_t total{ 0 };
+            for (std::size_t i(0); i < m_words.size(); ++i)
+            {
+                total += popCount(m_words[i] & other.m_words[i]);
+            }
+
+            return total;
+        }
+
+        void clearUnusedBits()
+        {
+            const std::size_t usedBitsInLastWord{ m_bitCount % bits_per_word };
+            if (!m_words.empty() && (usedBitsInLastWord > 0))
+            {
+                m_words.back() &= ((Word_t(1) << usedBitsInLastWord) - 1);
+            }
+        }
+
+        static std::size_t popCount(const Word_t word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+            Word_t temp{ word };
+            temp = temp - ((temp >> 1) & 0x5555555555555555ULL);
+            temp = (temp & 0x3333333333333333ULL) + ((temp >> 2) & 0x3333333333333333ULL);
+            temp = (temp + (temp >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            return static_cast<std::size_t>((temp * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        // word must not be zero
+        static std::size_t lowestSetBit(const Word_t word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+            return popCount((word & (~word + 1)) - 1);
+#endif
+        }
+
+      private:
+        static Word_t bitMask(const std::size_t index)
+        {
+            return (Word_t(1) << (index % bits_per_word));
+        }
+
+      private:
+        std::vector<Word_t> m_words;
+        std::size_t m_bitCount{ 0 };
+    };
+
+    inline BitBoard operator|(BitBoard left, const BitBoard & right)
+    {
+        left |= right;
+        return left;
+    }
+
+    inline BitBoard operator&(BitBoard left, const BitBoard & right)
+    {
+        left &= right;
+        return left;
+    }
+
+    inline BitBoard operator<<(BitBoard bits, const std::size_t shiftCount)
+    {
+        bits <<= shiftCount;
+        return bits;
+    }
+
+    inline BitBoard operator>>(BitBoard bits, const std::size_t shiftCount)
+    {
+        bits >>= shiftCount;
+        return bits;
+    }
+} // namespace util
+
+#endif // BIT_BOARD_HPP_INCLUDED
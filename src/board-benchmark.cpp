@@ -0,0 +1,336 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// board-benchmark.cpp
+//
+#include "board-benchmark.hpp"
+
+#include "board-history.hpp"
+#include "check-macros.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace snake
+{
+    BoardBenchmark::BoardBenchmark(const GameConfig & config)
+        : m_config(config)
+        , m_layout()
+        , m_worldPtr()
+    {
+        // nobody is watching, so the AI has to play
+        m_config.is_headless = true;
+        m_config.will_ai_drive_player = true;
+
+        M_CHECK_SS((m_config.sim_ticks_per_sec > 0), m_config.sim_ticks_per_sec);
+        M_CHECK_SS((m_config.headless_tick_limit > 0), m_config.headless_tick_limit);
+
+        if ((0 == m_config.resolution.x) || (0 == m_config.resolution.y))
+        {
+            m_config.resolution = m_defaultResolution;
+        }
+
+        m_layout.reset(m_config);
+        m_worldPtr = std::make_unique<BatchWorld>(m_config, m_layout);
+    }
+
+    void BoardBenchmark::snapshots(const std::size_t tickCount, const Seed_t seed)
+    {
+        BatchWorld & world{ *m_worldPtr };
+        BoardHistory history(m_historyLength);
+
+        Seed_t nextSeed{ seed };
+        world.start(nextSeed++);
+
+        // what a snapshot would cost if nothing was shared
+        std::vector<PosEntryOpt_t> cellsCopy(m_layout.cell_count_total_st);
+
+        Clock_t::duration snapshotTime{ 0 };
+        Clock_t::duration copyTime{ 0 };
+        Clock_t::duration rewindTime{ 0 };
+        std::size_t rewindCount{ 0 };
+
+        for (std::size_t tickIndex(0); tickIndex < tickCount; ++tickIndex)
+        {
+            // snapshots are only valid until Board::reset(), and after a new level the rest of
+            // the game would not match the board any more
+            if (tick(nextSeed))
+            {
+                history.clear();
+            }
+
+            auto startTime{ Clock_t::now() };
+            history.push(world.board());
+            snapshotTime += (Clock_t::now() - startTime);
+
+            startTime = Clock_t::now();
+            for (std::size_t index(0); index < cellsCopy.size(); ++index)
+            {
+                cellsCopy[index] = world.board().entryAt(m_layout.cellPosition(index));
+            }
+            copyTime += (Clock_t::now() - startTime);
+
+            if ((tickIndex % m_rewindInterval) == (m_rewindInterval - 1))
+            {
+                startTime = Clock_t::now();
+                rewindCount += static_cast<std::size_t>(world.rewind(history, m_rewindSteps));
+                rewindTime += (Clock_t::now() - startTime);
+            }
+        }
+
+        printBoard(tickCount, (nextSeed - seed));
+
+        std::cout << "Snapshot: " << microsecEach(snapshotTime, tickCount)
+                  << "us (copying every cell: " << microsecEach(copyTime, tickCount) << "us)\n";
+
+        std::cout << "Rewind " << m_rewindSteps
+                  << " Ticks: " << microsecEach(rewindTime, rewindCount) << "us (" << rewindCount
+                  << " times)" << std::endl;
+    }
+
+    void BoardBenchmark::cellLookups(const std::size_t tickCount, const Seed_t seed)
+    {
+        BatchWorld & world{ *m_worldPtr };
+        const Board & board{ world.board() };
+
+        Seed_t nextSeed{ seed };
+        world.start(nextSeed++);
+
+        std::map<BoardPos_t, PosEntry> posEntryMap;
+        BoardPosVec_t lookupPositions;
+
+        Clock_t::duration gridTime{ 0 };
+        Clock_t::duration mapTime{ 0 };
+        std::size_t lookupCount{ 0 };
+
+        for (std::size_t tickIndex(0); tickIndex < tickCount; ++tickIndex)
+        {
+            tick(nextSeed);
+
+            posEntryMap.clear();
+            for (std::size_t index(0); index < m_layout.cell_count_total_st; ++index)
+            {
+                const BoardPos_t pos{ m_layout.cellPosition(index) };
+                const PosEntryOpt_t entryOpt{ board.entryAt(pos) };
+
+                if (entryOpt)
+                {
+                    posEntryMap.emplace(pos, entryOpt.value());
+                }
+            }
+
+            lookupPositions.clear();
+            for (const HeadPiece & headPiece : board.headPieces())
+            {
+                const std::size_t headIndex{ m_layout.cellIndex(headPiece.position()) };
+                lookupPositions.push_back(headPiece.position());
+
+                for (const std::uint32_t neighborIndex : m_layout.neighbors(headIndex))
+                {
+                    lookupPositions.push_back(m_layout.cellPosition(neighborIndex));
+                }
+            }
+
+            // a few heads is too few lookups to time on their own
+            std::size_t gridFoundCount{ 0 };
+            auto startTime{ Clock_t::now() };
+            for (std::size_t repeat(0); repeat < m_lookupRepeatCount; ++repeat)
+            {
+                for (const BoardPos_t & pos : lookupPositions)
+                {
+                    gridFoundCount += static_cast<std::size_t>(board.entryAt(pos).has_value());
+                }
+            }
+            gridTime += (Clock_t::now() - startTime);
+
+            std::size_t mapFoundCount{ 0 };
+            startTime = Clock_t::now();
+            for (std::size_t repeat(0); repeat < m_lookupRepeatCount; ++repeat)
+            {
+                for (const BoardPos_t & pos : lookupPositions)
+                {
+                    mapFoundCount += posEntryMap.count(pos);
+                }
+            }
+            mapTime += (Clock_t::now() - startTime);
+
+            M_CHECK_SS(
+                (gridFoundCount == mapFoundCount),
+                "grid_found=" << gridFoundCount << ", map_found=" << mapFoundCount);
+
+            lookupCount += (lookupPositions.size() * m_lookupRepeatCount);
+        }
+
+        printBoard(tickCount, (nextSeed - seed));
+
+        std::cout << "Lookups: " << lookupCount << " with " << posEntryMap.size()
+                  << " pieces on the last board\n";
+
+        std::cout << "Grid Lookup: " << nanosecEach(gridTime, lookupCount)
+                  << "ns (std::map: " << nanosecEach(mapTime, lookupCount) << "ns)" << std::endl;
+    }
+
+    void BoardBenchmark::distanceQueries(const std::size_t tickCount, const Seed_t seed)
+    {
+        BatchWorld & world{ *m_worldPtr };
+        const Board & board{ world.board() };
+
+        Seed_t nextSeed{ seed };
+        world.start(nextSeed++);
+
+        Clock_t::duration ringTime{ 0 };
+        Clock_t::duration scanTime{ 0 };
+        std::size_t queryCount{ 0 };
+        std::size_t foundCount{ 0 };
+
+        for (std::size_t tickIndex(0); tickIndex < tickCount; ++tickIndex)
+        {
+            tick(nextSeed);
+
+            const HeadPiece * const playerPtr{ board.headPieces().find(board.playerHandle()) };
+            if (nullptr == playerPtr)
+            {
+                continue;
+            }
+
+            for (const int distance : m_queryDistances)
+            {
+                for (const DistanceRule rule :
+                     { DistanceRule::Exact, DistanceRule::Inside, DistanceRule::Outside })
+                {
+                    auto startTime{ Clock_t::now() };
+
+                    BoardPosVec_t ringPositions{
+                        board.findFreeBoardPosAtDistance(world.context(), distance, rule, 0)
+                    };
+
+                    ringTime += (Clock_t::now() - startTime);
+
+                    startTime = Clock_t::now();
+
+                    BoardPosVec_t scanPositions{
+                        findFreeBoardPosAtDistanceByScan(playerPtr->position(), distance, rule)
+                    };
+
+                    scanTime += (Clock_t::now() - startTime);
+
+                    std::sort(std::begin(ringPositions), std::end(ringPositions));
+                    std::sort(std::begin(scanPositions), std::end(scanPositions));
+
+                    M_CHECK_SS(
+                        (ringPositions == scanPositions),
+                        "distance=" << distance << ", rule=" << static_cast<int>(rule)
+                                    << ", ring_found=" << ringPositions.size()
+                                    << ", scan_found=" << scanPositions.size());
+
+                    ++queryCount;
+                    foundCount += ringPositions.size();
+                }
+            }
+        }
+
+        printBoard(tickCount, (nextSeed - seed));
+
+        std::cout << "Queries: " << queryCount << " finding " << foundCount << " cells\n";
+
+        std::cout << "Ring Query: " << microsecEach(ringTime, queryCount)
+                  << "us (scanning every free cell: " << microsecEach(scanTime, queryCount)
+                  << "us)" << std::endl;
+    }
+
+    bool BoardBenchmark::tick(Seed_t & nextSeed)
+    {
+        BatchWorld & world{ *m_worldPtr };
+        const std::size_t levelBefore{ world.game().level().number };
+        const std::size_t lifeLostCountBefore{ world.lifeLostCount() };
+
+        if (!world.tick())
+        {
+            world.start(nextSeed++);
+            return true;
+        }
+
+        // losing a life loads the same level again
+        return (
+            (world.game().level().number != levelBefore) ||
+            (world.lifeLostCount() != lifeLostCountBefore));
+    }
+
+    BoardPosVec_t BoardBenchmark::findFreeBoardPosAtDistanceByScan(
+        const BoardPos_t & centerPos,
+        const int targetDistance,
+        const DistanceRule distanceRule) const
+    {
+        const Context & context{ m_worldPtr->context() };
+
+        BoardPosVec_t finalPositions;
+
+        const BoardPosVec_t allFreePositions{ m_worldPtr->board().findAllFreePositions(context) };
+        if (allFreePositions.empty() || (targetDistance <= 0))
+        {
+            return finalPositions;
+        }
+
+        std::multimap<int, BoardPos_t> targetDistPositions;
+        for (const BoardPos_t & pos : allFreePositions)
+        {
+            const int distanceFromTarget{ std::abs(pos.x - centerPos.x) +
+                                          std::abs(pos.y - centerPos.y) };
+
+            if ((distanceRule == DistanceRule::Exact) && (distanceFromTarget != targetDistance))
+            {
+                continue;
+            }
+
+            if ((distanceRule == DistanceRule::Inside) && (distanceFromTarget > targetDistance))
+            {
+                continue;
+            }
+
+            if ((distanceRule == DistanceRule::Outside) && (distanceFromTarget < targetDistance))
+            {
+                continue;
+            }
+
+            targetDistPositions.insert({ distanceFromTarget, pos });
+        }
+
+        finalPositions.reserve(targetDistPositions.size());
+        for (const auto & distPosPair : targetDistPositions)
+        {
+            finalPositions.push_back(distPosPair.second);
+        }
+
+        std::sort(std::begin(finalPositions), std::end(finalPositions));
+
+        finalPositions.erase(
+            std::unique(std::begin(finalPositions), std::end(finalPositions)),
+            std::end(finalPositions));
+
+        context.random.shuffle(finalPositions);
+        return finalPositions;
+    }
+
+    void BoardBenchmark::printBoard(const std::size_t tickCount, const std::size_t gameCount) const
+    {
+        std::cout << "Board: " << m_layout.cell_counts.x << 'x' << m_layout.cell_counts.y
+                  << " cells, " << tickCount << " ticks over " << gameCount << " games\n";
+    }
+
+    double BoardBenchmark::microsecEach(const Clock_t::duration duration, const std::size_t count)
+    {
+        const std::chrono::duration<double, std::micro> micro{ duration };
+        return (micro.count() / static_cast<double>(std::max(1_st, count)));
+    }
+
+    double BoardBenchmark::nanosecEach(const Clock_t::duration duration, const std::size_t count)
+    {
+        const std::chrono::duration<double, std::nano> nano{ duration };
+        return (nano.count() / static_cast<double>(std::max(1_st, count)));
+    }
+} // namespace snake
@@ -0,0 +1,73 @@
+#ifndef SNAKE_BOARD_BENCHMARK_HPP_INCLUDED
+#define SNAKE_BOARD_BENCHMARK_HPP_INCLUDED
+//
+// board-benchmark.hpp
+//
+#include "batch-simulator.hpp"
+#include "layout.hpp"
+#include "settings.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace snake
+{
+    // Times parts of the Board on their own while the AI plays, for the costs that are too
+    // small to see in BatchSimulator results.  Each one also times the simpler way the same
+    // thing could be done on the same boards, so the two can be compared on any machine.
+    class BoardBenchmark
+    {
+      public:
+        explicit BoardBenchmark(const GameConfig & config);
+
+        // Pushes every tick to a BoardHistory and rewinds it every few ticks, then prints how
+        // long snapshot() and rewinding took next to copying every cell out of the board.
+        void snapshots(const std::size_t tickCount, const Seed_t seed);
+
+        // Every tick looks up the head and its eight neighbors for every snake the way taking
+        // turns does, once in the Board's dense grid and once in a std::map of the same pieces
+        // (which is how the Board used to keep them), then prints how long a lookup took in each.
+        void cellLookups(const std::size_t tickCount, const Seed_t seed);
+
+        // Every tick finds the free cells a few distances from the player with every
+        // DistanceRule, once with findFreeBoardPosAtDistance() and once with the scan of every
+        // free cell it used to do, checks both found the same cells, and prints how long each
+        // took.
+        void distanceQueries(const std::size_t tickCount, const Seed_t seed);
+
+      private:
+        using Clock_t = std::chrono::steady_clock;
+
+        // plays one tick and starts a new game once the old one ends, returns true if the board
+        // was started over or its level was loaded again
+        bool tick(Seed_t & nextSeed);
+
+        // findFreeBoardPosAtDistance() before DistanceRingQuery, kept only to compare against
+        BoardPosVec_t findFreeBoardPosAtDistanceByScan(
+            const BoardPos_t & centerPos,
+            const int targetDistance,
+            const DistanceRule distanceRule) const;
+
+        void printBoard(const std::size_t tickCount, const std::size_t gameCount) const;
+
+        static double microsecEach(const Clock_t::duration duration, const std::size_t count);
+        static double nanosecEach(const Clock_t::duration duration, const std::size_t count);
+
+      private:
+        GameConfig m_config;
+        Layout m_layout;
+        std::unique_ptr<BatchWorld> m_worldPtr;
+
+        static inline const std::size_t m_historyLength{ 64 };
+        static inline const std::size_t m_rewindInterval{ 16 };
+        static inline const std::size_t m_rewindSteps{ 8 };
+        static inline const std::size_t m_lookupRepeatCount{ 32 };
+        static inline const std::array<int, 3> m_queryDistances{ 3, 10, 30 };
+
+        static inline const sf::Vector2u m_defaultResolution{ 1920u, 1080u };
+    };
+} // namespace snake
+
+#endif // SNAKE_BOARD_BENCHMARK_HPP_INCLUDED
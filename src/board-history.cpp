@@ -0,0 +1,40 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// board-history.cpp
+//
+#include "board-history.hpp"
+
+#include "check-macros.hpp"
+
+namespace snake
+{
+    BoardHistory::BoardHistory(const std::size_t capacity)
+        : m_capacity(capacity)
+        , m_snapshots()
+    {
+        M_CHECK_SS((m_capacity > 0), m_capacity);
+    }
+
+    void BoardHistory::push(const Board & board)
+    {
+        if (m_snapshots.size() >= m_capacity)
+        {
+            m_snapshots.pop_front();
+        }
+
+        m_snapshots.push_back(board.snapshot());
+    }
+
+    bool BoardHistory::rewind(Context & context, Board & board, const std::size_t stepsBack)
+    {
+        if (stepsBack >= m_snapshots.size())
+        {
+            return false;
+        }
+
+        m_snapshots.resize(m_snapshots.size() - stepsBack);
+        board.restore(context, m_snapshots.back());
+        return true;
+    }
+} // namespace snake
@@ -0,0 +1,44 @@
+#ifndef SNAKE_BOARD_HISTORY_HPP_INCLUDED
+#define SNAKE_BOARD_HISTORY_HPP_INCLUDED
+//
+// board-history.hpp
+//
+#include "board.hpp"
+
+#include <cstddef>
+#include <deque>
+
+namespace snake
+{
+    struct Context;
+
+    // The last few snapshots of one Board, for rewinding play or for trying moves ahead and
+    // taking them back.  Snapshots taken one turn apart share every chunk that turn did not
+    // change, so keeping many of them costs about as much as the cells that changed.  Only the
+    // Board is kept, so whoever rewinds it has to put the rest of the game back themselves.
+    class BoardHistory
+    {
+      public:
+        explicit BoardHistory(const std::size_t capacity);
+
+        bool empty() const { return m_snapshots.empty(); }
+        std::size_t size() const { return m_snapshots.size(); }
+        std::size_t capacity() const { return m_capacity; }
+
+        void clear() { m_snapshots.clear(); }
+
+        // forgets the oldest once full
+        void push(const Board & board);
+
+        // Puts the board back the way it was stepsBack pushes ago, where zero is the last push,
+        // and forgets every push after that one.  Returns false and changes nothing if there
+        // are not that many.
+        bool rewind(Context & context, Board & board, const std::size_t stepsBack);
+
+      private:
+        std::size_t m_capacity;
+        std::deque<BoardSnapshot> m_snapshots;
+    };
+} // namespace snake
+
+#endif // SNAKE_BOARD_HISTORY_HPP_INCLUDED
@@ -0,0 +1,685 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// board-view.cpp
+//
+#include "board-view.hpp"
+
+#include "board.hpp"
+#include "check-macros.hpp"
+#include "colors.hpp"
+#include "context.hpp"
+#include "graphics-util.hpp"
+#include "layout.hpp"
+#include "pixel-layout.hpp"
+#include "settings.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace snake
+{
+    void BoardView::reset(const Layout & layout)
+    {
+        m_cellQuadIndexes.assign(layout.cell_count_total_st, m_noQuadIndex);
+
+        m_pieceVerts.clear();
+        m_dirtyQuadIndexes.clear();
+        m_isQuadDirty.clear();
+        m_willUploadAllVerts = true;
+        m_isStaticLayerStale = true;
+        m_freeQuadIndexes.clear();
+        m_quadCellIndexes.clear();
+        m_tailSequence = 0;
+
+        m_pieceVerts.reserve(10000);
+        m_freeQuadIndexes.reserve(10000 / util::verts_per_quad);
+        m_quadCellIndexes.reserve(10000 / util::verts_per_quad);
+    }
+
+    void BoardView::loadShaders()
+    {
+        m_tailShader.load(piece::tail_color_light, piece::tail_color_dark);
+    }
+
+    void BoardView::onBoardCleared(const FrontEndContext & context) { reset(context.layout); }
+
+    void BoardView::onCellChanged(
+        const FrontEndContext & context,
+        const std::size_t cellIndex,
+        const PieceEnumOpt_t & pieceBefore,
+        const PieceEnumOpt_t & pieceAfter,
+        const util::SlotHandle & owner)
+    {
+        if ((pieceBefore == Piece::Wall) || (pieceAfter == Piece::Wall))
+        {
+            m_isStaticLayerStale = true;
+        }
+
+        // any quad freed here is on top of the free stack so it will be re-used right below
+        if (const std::size_t quadIndex{ m_cellQuadIndexes[cellIndex] }; m_noQuadIndex != quadIndex)
+        {
+            freeQuad(quadIndex);
+            m_cellQuadIndexes[cellIndex] = m_noQuadIndex;
+        }
+
+        if (!pieceAfter || !hasQuad(pieceAfter.value()))
+        {
+            return;
+        }
+
+        const std::size_t quadIndex{ allocateQuad(cellIndex) };
+        setupQuad(context, quadIndex, cellIndex, pieceColor(context, pieceAfter.value(), owner));
+        m_cellQuadIndexes[cellIndex] = quadIndex;
+
+        // only the player's tail is stamped for the gradient, see TailGradientShader
+        if ((Piece::Tail == pieceAfter) && (owner == context.board.playerHandle()))
+        {
+            // the Board adds to the tail before it says so, so one means the tail just started
+            if (context.board.playerTailPositions().size() <= 1)
+            {
+                m_tailSequence = 0;
+            }
+
+            ++m_tailSequence;
+            texCoordQuad(quadIndex, { static_cast<float>(m_tailSequence), 1.0f });
+        }
+    }
+
+    void BoardView::onPieceMoved(
+        const FrontEndContext & context,
+        const std::size_t fromCellIndex,
+        const std::size_t toCellIndex)
+    {
+        const std::size_t quadIndex{ m_cellQuadIndexes[fromCellIndex] };
+        if (m_noQuadIndex == quadIndex)
+        {
+            return;
+        }
+
+        m_cellQuadIndexes[fromCellIndex] = m_noQuadIndex;
+        m_cellQuadIndexes[toCellIndex] = quadIndex;
+        m_quadCellIndexes[quadIndex / util::verts_per_quad] = toCellIndex;
+
+        const BoardPos_t toPos{ context.layout.cellPosition(toCellIndex) };
+        positionQuad(quadIndex, context.pixel_layout.cellBounds(toPos));
+    }
+
+    void BoardView::onPlayerTailChanged(const FrontEndContext & context)
+    {
+        const TailPositions_t & tailPositions{ context.board.playerTailPositions() };
+
+        if (m_tailShader.isLoaded())
+        {
+            m_tailShader.update(static_cast<float>(m_tailSequence), tailPositions.size());
+        }
+        else
+        {
+            float index{ 0.0f };
+            const float count{ static_cast<float>(tailPositions.size()) };
+            for (const BoardPos_t & pos : tailPositions)
+            {
+                colorQuad(
+                    m_cellQuadIndexes[context.layout.cellIndex(pos)],
+                    util::colorBlend(
+                        (index / count), piece::tail_color_light, piece::tail_color_dark));
+
+                index += 1.0f;
+            }
+        }
+
+        compactQuadsIfFragmented();
+    }
+
+    void BoardView::onBoardRestored(const FrontEndContext & context)
+    {
+        reStampTailQuads(context);
+        onPlayerTailChanged(context);
+    }
+
+    void BoardView::interpolateHeads(const FrontEndContext & context)
+    {
+        if (m_cellQuadIndexes.empty())
+        {
+            return;
+        }
+
+        for (const HeadPiece & headPiece : context.board.headPieces())
+        {
+            const BoardPos_t pos{ headPiece.position() };
+            const std::size_t quadIndex{ m_cellQuadIndexes[context.layout.cellIndex(pos)] };
+            if (m_noQuadIndex == quadIndex)
+            {
+                continue;
+            }
+
+            sf::FloatRect rect{ context.pixel_layout.cellBounds(pos) };
+
+            // nothing to slide across if it just wrapped around the board or was just placed
+            const BoardPos_t posPrev{ headPiece.positionPrev() };
+            if ((std::abs(pos.x - posPrev.x) + std::abs(pos.y - posPrev.y)) == 1)
+            {
+                const sf::FloatRect rectPrev{ context.pixel_layout.cellBounds(posPrev) };
+                const float ratio{ headPiece.turnProgressRatio(context.sim_tick_ratio) };
+                rect.left += ((rectPrev.left - rect.left) * (1.0f - ratio));
+                rect.top += ((rectPrev.top - rect.top) * (1.0f - ratio));
+            }
+
+            positionQuad(quadIndex, rect);
+        }
+
+#if defined(SNAKE_WILL_VALIDATE_BOARD)
+        if (++m_framesSinceValidate >= context.config.board_validate_tick_interval)
+        {
+            m_framesSinceValidate = 0;
+            validate(context);
+        }
+#endif
+    }
+
+    void BoardView::draw(
+        const FrontEndContext & context,
+        sf::RenderTarget & target,
+        const sf::RenderStates & states) const
+    {
+        updateStaticLayer(context);
+
+        if (m_isStaticLayerTextureValid)
+        {
+            target.draw(m_staticLayerSprite, states);
+        }
+        else
+        {
+            drawStaticLayer(context, target, states);
+        }
+
+        if (!m_pieceVerts.empty())
+        {
+            sf::RenderStates pieceStates{ states };
+            if (!pieceStates.shader)
+            {
+                pieceStates.shader = m_tailShader.shader();
+            }
+
+            if (uploadDirtyQuads())
+            {
+                target.draw(m_pieceVertBuffer, 0, m_pieceVerts.size(), pieceStates);
+            }
+            else
+            {
+                target.draw(&m_pieceVerts[0], m_pieceVerts.size(), sf::Quads, pieceStates);
+            }
+        }
+    }
+
+    void BoardView::drawStaticLayer(
+        const FrontEndContext & context,
+        sf::RenderTarget & target,
+        const sf::RenderStates & states) const
+    {
+        // board region outline
+        sf::FloatRect outlineRect = context.pixel_layout.board_bounds_f;
+        outlineRect.left -= 1.0f;
+        outlineRect.top -= 1.0f;
+        outlineRect.width += 2.0f;
+        outlineRect.height += 2.0f;
+
+        util::drawRectangleShape(
+            target, outlineRect, false, color::alt_board_background + sf::Color(25, 25, 25));
+
+        // draw every other cell with a slightly brighter color for a nice looking checker pattern
+        if (!m_cellVerts.empty())
+        {
+            target.draw(&m_cellVerts[0], m_cellVerts.size(), sf::Quads, states);
+        }
+
+        if (!m_wallVerts.empty())
+        {
+            target.draw(&m_wallVerts[0], m_wallVerts.size(), sf::Quads, states);
+        }
+    }
+
+    void BoardView::updateStaticLayer(const FrontEndContext & context) const
+    {
+        const Layout & layout{ context.layout };
+        const PixelLayout & pixelLayout{ context.pixel_layout };
+
+        if (!m_isStaticLayerStale && (m_staticLayerLayoutRevision == layout.revision()))
+        {
+            return;
+        }
+
+        if (m_staticLayerLayoutRevision != layout.revision())
+        {
+            m_cellVerts.clear();
+            m_cellVerts.reserve((layout.cell_count_total_st / 2) * util::verts_per_quad);
+
+            for (int vert(0); vert < layout.cell_counts.y; ++vert)
+            {
+                for (int horiz(0); horiz < layout.cell_counts.x; ++horiz)
+                {
+                    if (((horiz % 2) == 0) == ((vert % 2) == 0))
+                    {
+                        continue;
+                    }
+
+                    util::appendQuadVerts(
+                        pixelLayout.cellBounds({ horiz, vert }),
+                        m_cellVerts,
+                        color::alt_board_background);
+                }
+            }
+        }
+
+        m_isStaticLayerStale = false;
+        m_staticLayerLayoutRevision = layout.revision();
+
+        const util::BitBoard & wallBits{ context.board.pieceBits(Piece::Wall) };
+
+        m_wallVerts.clear();
+        m_wallVerts.reserve(wallBits.count() * util::verts_per_quad);
+
+        const sf::Color wallColor{ piece::toColor(Piece::Wall) };
+        wallBits.forEachSetBit([&](const std::size_t index) {
+            const sf::FloatRect rect{ pixelLayout.cellBounds(layout.cellPosition(index)) };
+            util::appendQuadVerts(rect, m_wallVerts, wallColor);
+        });
+
+        // one pixel of margin on every side for the outline
+        sf::FloatRect layerRect{ pixelLayout.board_bounds_f };
+        layerRect.left -= 1.0f;
+        layerRect.top -= 1.0f;
+        layerRect.width += 2.0f;
+        layerRect.height += 2.0f;
+
+        const sf::Vector2u layerSize{ static_cast<unsigned int>(std::ceil(layerRect.width)),
+                                      static_cast<unsigned int>(std::ceil(layerRect.height)) };
+
+        if ((layerSize.x == 0) || (layerSize.y == 0))
+        {
+            m_isStaticLayerTextureValid = false;
+            return;
+        }
+
+        if (m_staticLayer.getSize() != layerSize)
+        {
+            m_isStaticLayerTextureValid = m_staticLayer.create(layerSize.x, layerSize.y);
+        }
+
+        if (!m_isStaticLayerTextureValid)
+        {
+            return;
+        }
+
+        m_staticLayer.setView(sf::View(layerRect));
+        m_staticLayer.clear(sf::Color::Transparent);
+        drawStaticLayer(context, m_staticLayer, sf::RenderStates());
+        m_staticLayer.display();
+
+        m_staticLayerSprite.setTexture(m_staticLayer.getTexture(), true);
+        m_staticLayerSprite.setPosition(layerRect.left, layerRect.top);
+    }
+
+    sf::Color BoardView::pieceColor(
+        const FrontEndContext & context, const Piece piece, const util::SlotHandle & owner) const
+    {
+        const bool isPlayers{ owner == context.board.playerHandle() };
+
+        if (Piece::Head == piece)
+        {
+            return ((isPlayers) ? piece::toColor(Piece::Head) : piece::rival_head_color);
+        }
+        else if ((Piece::Tail == piece) && !isPlayers)
+        {
+            return piece::rival_tail_color;
+        }
+
+        return piece::toColor(piece);
+    }
+
+    QuadStats BoardView::quadStats() const
+    {
+        QuadStats stats;
+
+        stats.quad_count = m_quadCellIndexes.size();
+        stats.free_count = m_freeQuadIndexes.size();
+        stats.used_count = (stats.quad_count - stats.free_count);
+
+        if (stats.quad_count > 0)
+        {
+            stats.fragmentation_ratio =
+                (static_cast<float>(stats.free_count) / static_cast<float>(stats.quad_count));
+        }
+
+        return stats;
+    }
+
+    void BoardView::compactQuads()
+    {
+        // fill the lowest holes first with whatever live quads are at the end
+        std::sort(std::begin(m_freeQuadIndexes), std::end(m_freeQuadIndexes));
+
+        auto trimFreeQuadsOffTheEnd = [&]() {
+            while (!m_quadCellIndexes.empty() &&
+                   (m_quadCellIndexes.back() >= m_cellQuadIndexes.size()))
+            {
+                m_quadCellIndexes.pop_back();
+                m_pieceVerts.resize(m_pieceVerts.size() - util::verts_per_quad);
+            }
+        };
+
+        for (const std::size_t holeQuadIndex : m_freeQuadIndexes)
+        {
+            trimFreeQuadsOffTheEnd();
+
+            if (holeQuadIndex >= m_pieceVerts.size())
+            {
+                break;
+            }
+
+            const std::size_t lastQuadIndex{ m_pieceVerts.size() - util::verts_per_quad };
+            const std::size_t cellIndexToPatch{ m_quadCellIndexes.back() };
+
+            std::copy(
+                (std::begin(m_pieceVerts) + static_cast<std::ptrdiff_t>(lastQuadIndex)),
+                std::end(m_pieceVerts),
+                (std::begin(m_pieceVerts) + static_cast<std::ptrdiff_t>(holeQuadIndex)));
+
+            m_cellQuadIndexes[cellIndexToPatch] = holeQuadIndex;
+            markQuadDirty(holeQuadIndex);
+            m_quadCellIndexes[holeQuadIndex / util::verts_per_quad] = cellIndexToPatch;
+
+            m_quadCellIndexes.pop_back();
+            m_pieceVerts.resize(lastQuadIndex);
+        }
+
+        trimFreeQuadsOffTheEnd();
+        m_freeQuadIndexes.clear();
+    }
+
+    void BoardView::compactQuadsIfFragmented()
+    {
+        if (quadStats().fragmentation_ratio > m_quadCompactFragmentationRatio)
+        {
+            compactQuads();
+        }
+    }
+
+    void BoardView::validate(const FrontEndContext & context) const
+    {
+        const Board & board{ context.board };
+        const std::size_t cellCount{ m_cellQuadIndexes.size() };
+
+        M_CHECK_SS(
+            (cellCount == context.layout.cell_count_total_st),
+            "cell_count=" << cellCount
+                          << ", layout.cell_count=" << context.layout.cell_count_total_st);
+
+        // every cell with a piece that isn't a wall owns exactly one quad that points back to it
+        std::size_t quadUsedCount{ 0 };
+        for (std::size_t index(0); index < cellCount; ++index)
+        {
+            const BoardPos_t pos{ context.layout.cellPosition(index) };
+            const PosEntryOpt_t entryOpt{ board.entryAt(pos) };
+            const std::size_t quadIndex{ m_cellQuadIndexes[index] };
+
+            if (!entryOpt || !hasQuad(entryOpt->piece_enum))
+            {
+                M_CHECK_SS(
+                    (m_noQuadIndex == quadIndex),
+                    "the cell at " << pos << " has a quad but nothing to draw there");
+
+                continue;
+            }
+
+            ++quadUsedCount;
+            const PosEntry & entry{ entryOpt.value() };
+
+            M_CHECK_SS(
+                (isQuadIndexValid(quadIndex) &&
+                 (m_quadCellIndexes[quadIndex / util::verts_per_quad] == index)),
+                "the quad at " << pos << " does not point back to it:  "
+                               << board.entryToString(entry));
+
+            // the player's tail gets re-colored, but nothing else ever changes color
+            const sf::Vertex & vertex{ m_pieceVerts[quadIndex] };
+            const bool isPlayerTail{ (Piece::Tail == entry.piece_enum) &&
+                                     (entry.piece_handle == board.playerHandle()) };
+
+            M_CHECK_SS(
+                ((vertex.texCoords.y > 0.5f) == isPlayerTail),
+                "only the player's tail should be stamped:  " << board.entryToString(entry));
+
+            if (!isPlayerTail)
+            {
+                M_CHECK_SS(
+                    (vertex.color == pieceColor(context, entry.piece_enum, entry.piece_handle)),
+                    "the quad at " << pos << " has the wrong color:  "
+                                   << board.entryToString(entry));
+            }
+        }
+
+        // and every quad not owned by a cell is on the free stack
+        std::size_t quadFreeCount{ 0 };
+        for (const std::size_t quadCellIndex : m_quadCellIndexes)
+        {
+            quadFreeCount += static_cast<std::size_t>(quadCellIndex >= cellCount);
+        }
+
+        M_CHECK_SS(
+            ((quadFreeCount == m_freeQuadIndexes.size()) &&
+             ((quadUsedCount + quadFreeCount) == m_quadCellIndexes.size()) &&
+             ((m_quadCellIndexes.size() * util::verts_per_quad) == m_pieceVerts.size())),
+            "quad_used_count=" << quadUsedCount << ", quad_free_count=" << quadFreeCount
+                               << ", free_stack_size=" << m_freeQuadIndexes.size()
+                               << ", quad_count=" << m_quadCellIndexes.size()
+                               << ", vert_count=" << m_pieceVerts.size());
+
+        for (const std::size_t quadIndex : m_freeQuadIndexes)
+        {
+            M_CHECK_SS(
+                (isQuadIndexValid(quadIndex) && isQuadFree(quadIndex) &&
+                 (m_pieceVerts[quadIndex].color == m_freeVertColor)),
+                "quad " << quadIndex << " is on the free stack but is in use or visible");
+        }
+    }
+
+    void BoardView::reStampTailQuads(const FrontEndContext & context)
+    {
+        const TailPositions_t & tailPositions{ context.board.playerTailPositions() };
+
+        // a restored tail can be longer than the count of pieces added since it last started
+        m_tailSequence = std::max(m_tailSequence, tailPositions.size());
+
+        // stamped even without the shader so that loading it later never finds stale numbers
+        std::size_t rank{ 0 };
+        for (const BoardPos_t & pos : tailPositions)
+        {
+            const std::size_t quadIndex{ m_cellQuadIndexes[context.layout.cellIndex(pos)] };
+            const float sequence{ static_cast<float>(m_tailSequence - rank) };
+            texCoordQuad(quadIndex, { sequence, 1.0f });
+            ++rank;
+        }
+    }
+
+    std::size_t BoardView::allocateQuad(const std::size_t cellIndexToUse)
+    {
+        if (!m_freeQuadIndexes.empty())
+        {
+            const std::size_t freeQuadIndex{ m_freeQuadIndexes.back() };
+            m_freeQuadIndexes.pop_back();
+            m_quadCellIndexes[freeQuadIndex / util::verts_per_quad] = cellIndexToUse;
+            return freeQuadIndex;
+        }
+
+        const std::size_t newQuadIndex{ m_pieceVerts.size() };
+        m_pieceVerts.resize((m_pieceVerts.size() + util::verts_per_quad), m_freeQuadVertex);
+        m_quadCellIndexes.push_back(cellIndexToUse);
+        return newQuadIndex;
+    }
+
+    void BoardView::setupQuad(
+        const FrontEndContext & context,
+        const std::size_t quadIndex,
+        const std::size_t cellIndex,
+        const sf::Color & color)
+    {
+        M_CHECK_SS(isQuadIndexValid(quadIndex), quadIndex);
+
+        colorQuad(quadIndex, color);
+        positionQuad(
+            quadIndex, context.pixel_layout.cellBounds(context.layout.cellPosition(cellIndex)));
+
+        // quads are re-used, so clear any tail sequence number left by a previous owner
+        texCoordQuad(quadIndex, { 0.0f, 0.0f });
+    }
+
+    bool BoardView::positionQuad(const std::size_t quadIndex, const sf::FloatRect & rect)
+    {
+        const sf::Vector2f rectPos{ rect.left, rect.top };
+        const sf::Vector2f rectEnd{ rectPos + sf::Vector2f(rect.width, rect.height) };
+
+        if ((m_pieceVerts[quadIndex + 0].position == rectPos) &&
+            (m_pieceVerts[quadIndex + 2].position == rectEnd))
+        {
+            return false;
+        }
+
+        // clang-format off
+        m_pieceVerts[quadIndex + 0].position = { rectPos + sf::Vector2f(      0.0f,        0.0f) };
+        m_pieceVerts[quadIndex + 1].position = { rectPos + sf::Vector2f(rect.width,        0.0f) };
+        m_pieceVerts[quadIndex + 2].position = { rectPos + sf::Vector2f(rect.width, rect.height) };
+        m_pieceVerts[quadIndex + 3].position = { rectPos + sf::Vector2f(      0.0f, rect.height) };
+        // clang-format on
+
+        markQuadDirty(quadIndex);
+        return true;
+    }
+
+    void BoardView::freeQuad(const std::size_t quadIndex)
+    {
+        colorQuad(quadIndex, m_freeVertColor);
+        m_quadCellIndexes[quadIndex / util::verts_per_quad] = m_cellQuadIndexes.size();
+        m_freeQuadIndexes.push_back(quadIndex);
+    }
+
+    void BoardView::colorQuad(const std::size_t quadIndex, const sf::Color & color)
+    {
+        M_CHECK_SS(isQuadIndexValid(quadIndex), quadIndex);
+
+        m_pieceVerts[quadIndex + 0].color = color;
+        m_pieceVerts[quadIndex + 1].color = color;
+        m_pieceVerts[quadIndex + 2].color = color;
+        m_pieceVerts[quadIndex + 3].color = color;
+
+        markQuadDirty(quadIndex);
+    }
+
+    void BoardView::texCoordQuad(const std::size_t quadIndex, const sf::Vector2f & texCoords)
+    {
+        M_CHECK_SS(isQuadIndexValid(quadIndex), quadIndex);
+
+        m_pieceVerts[quadIndex + 0].texCoords = texCoords;
+        m_pieceVerts[quadIndex + 1].texCoords = texCoords;
+        m_pieceVerts[quadIndex + 2].texCoords = texCoords;
+        m_pieceVerts[quadIndex + 3].texCoords = texCoords;
+
+        markQuadDirty(quadIndex);
+    }
+
+    void BoardView::markQuadDirty(const std::size_t quadIndex)
+    {
+        const std::size_t quadNumber{ quadIndex / util::verts_per_quad };
+
+        if (quadNumber >= m_isQuadDirty.size())
+        {
+            m_isQuadDirty.resize((quadNumber + 1), false);
+        }
+
+        if (!m_isQuadDirty[quadNumber])
+        {
+            m_isQuadDirty[quadNumber] = true;
+            m_dirtyQuadIndexes.push_back(quadIndex);
+        }
+    }
+
+    bool BoardView::uploadDirtyQuads() const
+    {
+        if (!sf::VertexBuffer::isAvailable())
+        {
+            return false;
+        }
+
+        const std::size_t vertCount{ m_pieceVerts.size() };
+
+        if (m_willUploadAllVerts || (vertCount > m_pieceVertBuffer.getVertexCount()))
+        {
+            // grow with room to spare so that adding pieces rarely forces a full upload
+            m_pieceVertBuffer.create(std::max(m_vertBufferCapacityMin, (vertCount * 2)));
+
+            if (vertCount > 0)
+            {
+                m_pieceVertBuffer.update(&m_pieceVerts[0], vertCount, 0);
+                m_uploadedVertexBytes += (vertCount * sizeof(sf::Vertex));
+            }
+
+            m_willUploadAllVerts = false;
+        }
+        else if (!m_dirtyQuadIndexes.empty())
+        {
+            std::sort(std::begin(m_dirtyQuadIndexes), std::end(m_dirtyQuadIndexes));
+
+            std::size_t runIndex{ 0 };
+            while (runIndex < m_dirtyQuadIndexes.size())
+            {
+                const std::size_t firstVert{ m_dirtyQuadIndexes[runIndex] };
+                std::size_t endVert{ firstVert + util::verts_per_quad };
+
+                ++runIndex;
+                while ((runIndex < m_dirtyQuadIndexes.size()) &&
+                       (m_dirtyQuadIndexes[runIndex] == endVert))
+                {
+                    endVert += util::verts_per_quad;
+                    ++runIndex;
+                }
+
+                // compactQuads() may have trimmed off quads that were dirty
+                endVert = std::min(endVert, vertCount);
+                if (firstVert >= endVert)
+                {
+                    continue;
+                }
+
+                const std::size_t runVertCount{ endVert - firstVert };
+
+                m_pieceVertBuffer.update(
+                    &m_pieceVerts[firstVert], runVertCount, static_cast<unsigned int>(firstVert));
+
+                m_uploadedVertexBytes += (runVertCount * sizeof(sf::Vertex));
+            }
+        }
+
+        for (const std::size_t quadIndex : m_dirtyQuadIndexes)
+        {
+            m_isQuadDirty[quadIndex / util::verts_per_quad] = false;
+        }
+
+        m_dirtyQuadIndexes.clear();
+        return true;
+    }
+
+    bool BoardView::isQuadIndexValid(const std::size_t quadIndex) const
+    {
+        const bool isMultipleOfFour{ (quadIndex % util::verts_per_quad) == 0 };
+        const bool isIndexInRange{ (quadIndex + util::verts_per_quad) <= m_pieceVerts.size() };
+        return (isMultipleOfFour && isIndexInRange);
+    }
+
+    bool BoardView::isQuadFree(const std::size_t quadIndex) const
+    {
+        M_CHECK_SS(isQuadIndexValid(quadIndex), quadIndex);
+
+        return (m_quadCellIndexes[quadIndex / util::verts_per_quad] >= m_cellQuadIndexes.size());
+    }
+} // namespace snake
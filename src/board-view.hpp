@@ -0,0 +1,183 @@
+#ifndef SNAKE_BOARD_VIEW_HPP_INCLUDED
+#define SNAKE_BOARD_VIEW_HPP_INCLUDED
+//
+// board-view.hpp
+//
+#include "common-types.hpp"
+#include "pieces.hpp"
+#include "slot-map.hpp"
+#include "tail-gradient-shader.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace snake
+{
+    struct FrontEndContext;
+
+    struct QuadStats
+    {
+        std::size_t quad_count{ 0 }; // all quads in the vertex array, both used and free
+        std::size_t used_count{ 0 };
+        std::size_t free_count{ 0 };
+
+        // zero means no holes, one means the vertex array is nothing but holes
+        float fragmentation_ratio{ 0.0f };
+    };
+
+    //
+
+    // Draws the Board.  Every piece but walls has one quad in m_pieceVerts, and they are only
+    // ever changed by the Board telling the GameCoordinator about a change, which passes it on
+    // to one of the on...() functions here, see IGameObserver.  Nothing here changes the Board.
+    class BoardView
+    {
+      public:
+        BoardView() = default;
+
+        void reset(const Layout & layout);
+
+        // needs an OpenGL context, so the GameCoordinator calls this once the window is open
+        void loadShaders();
+
+        // the outline, checkerboard and walls get drawn into m_staticLayer again on next draw()
+        void invalidateStaticLayer() { m_isStaticLayerStale = true; }
+
+        void onBoardCleared(const FrontEndContext & context);
+
+        void onCellChanged(
+            const FrontEndContext & context,
+            const std::size_t cellIndex,
+            const PieceEnumOpt_t & pieceBefore,
+            const PieceEnumOpt_t & pieceAfter,
+            const util::SlotHandle & owner);
+
+        void onPieceMoved(
+            const FrontEndContext & context,
+            const std::size_t fromCellIndex,
+            const std::size_t toCellIndex);
+
+        // Only the player's tail has the gradient, rival tails are one color.  O(1) when the tail
+        // shader is loaded, otherwise re-colors every quad of the player's tail on the CPU.
+        void onPlayerTailChanged(const FrontEndContext & context);
+
+        void onBoardRestored(const FrontEndContext & context);
+
+        // Once per frame before draw(), slides each head quad from its previous cell toward its
+        // current one by how far it is into its turn.  O(heads) and only re-uploads the heads
+        // that actually moved on screen, and never changes anything but the head quads.  Does
+        // nothing if reset() was never called, which is how it stays out of headless games.
+        void interpolateHeads(const FrontEndContext & context);
+
+        void draw(const FrontEndContext & context, sf::RenderTarget &, const sf::RenderStates &)
+            const;
+
+        QuadStats quadStats() const;
+
+        // moves live quads down into free holes and trims the vertex array
+        void compactQuads();
+        void compactQuadsIfFragmented();
+
+        // bytes of vertex data sent to the GPU by draw() since the last reset
+        std::size_t uploadedVertexBytes() const { return m_uploadedVertexBytes; }
+        void resetUploadedVertexBytes() { m_uploadedVertexBytes = 0; }
+
+        // Cross-checks every quad against the Board and the free stack and fails an M_CHECK on
+        // the first mismatch.  O(cells + quads), and interpolateHeads() only calls it when built
+        // with BOARD_VALIDATION.
+        void validate(const FrontEndContext & context) const;
+
+      private:
+        // what a head or tail should be colored, the same as piece::toColor() for the rest
+        sf::Color pieceColor(
+            const FrontEndContext & context,
+            const Piece piece,
+            const util::SlotHandle & owner) const;
+
+        std::size_t allocateQuad(const std::size_t cellIndex);
+
+        void setupQuad(
+            const FrontEndContext & context,
+            const std::size_t quadIndex,
+            const std::size_t cellIndex,
+            const sf::Color & color);
+
+        // returns false without marking it dirty if the quad was already there
+        bool positionQuad(const std::size_t quadIndex, const sf::FloatRect & rect);
+
+        void freeQuad(const std::size_t quadIndex);
+        void colorQuad(const std::size_t quadIndex, const sf::Color & color);
+        void texCoordQuad(const std::size_t quadIndex, const sf::Vector2f & texCoords);
+
+        // every change to m_pieceVerts has to call this so draw() knows what to upload
+        void markQuadDirty(const std::size_t quadIndex);
+
+        // returns false if vertex buffers are not available and m_pieceVerts must be drawn
+        bool uploadDirtyQuads() const;
+
+        // walls never move or change color, so they are drawn in the static layer instead
+        static bool hasQuad(const Piece piece) { return (Piece::Wall != piece); }
+
+        // everything that only changes when the level or layout does
+        void drawStaticLayer(
+            const FrontEndContext & context, sf::RenderTarget &, const sf::RenderStates &) const;
+
+        void updateStaticLayer(const FrontEndContext & context) const;
+
+        // re-writes every tail sequence number, O(tail length)
+        void reStampTailQuads(const FrontEndContext & context);
+
+        bool isQuadIndexValid(const std::size_t index) const;
+        bool isQuadFree(const std::size_t index) const;
+
+      private:
+        static inline const sf::Color m_freeVertColor{ sf::Color::Transparent };
+        static inline const sf::Vertex m_freeQuadVertex{ { 0.0f, 0.0f }, m_freeVertColor };
+
+        static inline const std::size_t m_noQuadIndex{ std::numeric_limits<std::size_t>::max() };
+
+        // one per Layout cell, the m_pieceVerts index of the quad there or m_noQuadIndex
+        std::vector<std::size_t> m_cellQuadIndexes;
+
+        std::vector<sf::Vertex> m_pieceVerts;
+
+        // stack of freed m_pieceVerts indexes ready for re-use, and the cell index each quad
+        // belongs to (or m_cellQuadIndexes.size() if free), which compactQuads() needs
+        std::vector<std::size_t> m_freeQuadIndexes;
+        std::vector<std::size_t> m_quadCellIndexes;
+
+        static inline const float m_quadCompactFragmentationRatio{ 0.5f };
+
+        // the GPU copy of m_pieceVerts, which only gets the dirty quads re-uploaded each frame,
+        // with consecutive dirty quads merged into a single upload
+        mutable sf::VertexBuffer m_pieceVertBuffer{ sf::Quads, sf::VertexBuffer::Dynamic };
+        mutable std::vector<std::size_t> m_dirtyQuadIndexes;
+        mutable std::vector<bool> m_isQuadDirty; // indexed by quadIndex / verts_per_quad
+        mutable bool m_willUploadAllVerts{ true };
+        mutable std::size_t m_uploadedVertexBytes{ 0 };
+
+        static inline const std::size_t m_vertBufferCapacityMin{ 10000 };
+
+        // re-drawn only when walls change, the map is loaded, or Layout::revision() changes,
+        // and if the render texture can't be made then drawStaticLayer() is used every frame
+        mutable sf::RenderTexture m_staticLayer;
+        mutable sf::Sprite m_staticLayerSprite;
+        mutable std::vector<sf::Vertex> m_cellVerts;
+        mutable std::vector<sf::Vertex> m_wallVerts;
+        mutable bool m_isStaticLayerStale{ true };
+        mutable bool m_isStaticLayerTextureValid{ false };
+        mutable std::size_t m_staticLayerLayoutRevision{ 0 };
+
+        // every new piece of the player's tail gets the next number, starting over whenever the
+        // tail is empty
+        TailGradientShader m_tailShader;
+        std::size_t m_tailSequence{ 0 };
+
+        std::size_t m_framesSinceValidate{ 0 };
+    };
+} // namespace snake
+
+#endif // SNAKE_BOARD_VIEW_HPP_INCLUDED
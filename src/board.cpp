@@ -3,35 +3,60 @@
 #include "board.hpp"
 
 #include "context.hpp"
+#include "game-observer.hpp"
 #include "layout.hpp"
-#include "media.hpp"
 #include "random.hpp"
 #include "settings.hpp"
 #include "util.hpp"
 
 #include <algorithm>
-#include <map>
-#include <set>
 
 namespace snake
 {
-    void Board::reset()
+    void Board::reset(const Layout & layout)
     {
-        m_posEntryMap.clear();
-        m_pieceVerts.clear();
-        m_headPieces.clear();
-        m_tailPieces.clear();
-        m_wallPieces.clear();
-        m_foodPieces.clear();
-        m_slowPieces.clear();
-        m_shrinkPieces.clear();
+        m_cellCounts = layout.cell_counts;
+        m_grid.assign(layout.cell_count_total_st, std::nullopt);
 
-        m_pieceVerts.reserve(10000);
-        m_headPieces.reserve(10);
-        m_wallPieces.reserve(5000);
-        m_foodPieces.reserve(1000);
-        m_slowPieces.reserve(100);
-        m_shrinkPieces.reserve(100);
+        m_freeCells.positions.assign(m_grid.size(), BoardPos_t{ 0, 0 });
+        m_freeCells.slots.assign(m_grid.size(), 0);
+        m_freeCells.count = m_grid.size();
+
+        for (util::BitBoard & bits : m_pieceBits)
+        {
+            bits.resize(m_grid.size());
+        }
+
+        m_notFirstColumnBits.resize(m_grid.size());
+        m_notLastColumnBits.resize(m_grid.size());
+        for (std::size_t index(0); index < m_grid.size(); ++index)
+        {
+            const int column{ cellPosition(index).x };
+
+            if (column != 0)
+            {
+                m_notFirstColumnBits.set(index);
+            }
+
+            if (column != (m_cellCounts.x - 1))
+            {
+                m_notLastColumnBits.set(index);
+            }
+        }
+
+        for (std::size_t index(0); index < m_grid.size(); ++index)
+        {
+            m_freeCells.positions.set(index, cellPosition(index));
+            m_freeCells.slots.set(index, index);
+        }
+
+        m_headPieces.write().clear();
+        m_tailPositions.clear();
+        m_foodPositions.clear();
+        m_playerHandle = {};
+        m_isFoodPositionsStale = true;
+
+        m_headPieces.write().reserve(10);
     }
 
     void Board::loadMap(Context & context, const bool willLoadNewMap)
@@ -48,25 +73,9 @@ namespace snake
 
     void Board::loadMap_New(Context & context)
     {
-        reset();
-
-        for (const BoardPos_t & pos : context.game.level().wall_positions)
-        {
-            replaceWithNewPiece(context, Piece::Wall, pos);
-        }
-
-        for (const BoardPos_t & pos : context.game.level().obstacle_positions)
-        {
-            replaceWithNewPiece(context, Piece::Wall, pos);
-        }
-
-        for (const BoardPos_t & pos : context.game.level().food_positions)
-        {
-            replaceWithNewPiece(context, Piece::Food, pos);
-        }
-
-        // always place head las in case other stuff was placed in start_pos
-        replaceWithNewPiece(context, Piece::Head, context.game.level().start_pos);
+        reset(context.layout);
+        context.observer.onBoardCleared();
+        placeLevelPieces(context);
     }
 
     void Board::loadMap_Same(Context & context)
@@ -78,23 +87,30 @@ namespace snake
         removeAllPieces(context, Piece::Slow);
         removeAllPieces(context, Piece::Wall);
 
-        for (const BoardPos_t & pos : context.game.level().wall_positions)
-        {
-            replaceWithNewPiece(context, Piece::Wall, pos);
-        }
-
-        for (const BoardPos_t & pos : context.game.level().obstacle_positions)
-        {
-            replaceWithNewPiece(context, Piece::Wall, pos);
-        }
+        placeLevelPieces(context);
+    }
 
-        for (const BoardPos_t & pos : context.game.level().food_positions)
+    void Board::placeLevelPieces(Context & context)
+    {
+        const Level & level{ context.game.level() };
+        const BoardPosVec_t startPositions{ level.start_pos };
+
+        // always place head last in case other stuff was placed in start_pos
+        buildPieces(
+            context,
+            { { Piece::Wall, level.wall_positions },
+              { Piece::Wall, level.obstacle_positions },
+              { Piece::Food, level.food_positions },
+              { Piece::Head, startPositions } });
+
+        m_headPieces.write().reserve(context.config.rival_snake_count + 1);
+        for (std::size_t i(0); i < context.config.rival_snake_count; ++i)
         {
-            replaceWithNewPiece(context, Piece::Food, pos);
+            if (!spawnRivalSnake(context))
+            {
+                break;
+            }
         }
-
-        // always place head las in case other stuff was placed in start_pos
-        replaceWithNewPiece(context, Piece::Head, context.game.level().start_pos);
     }
 
     bool Board::isPiece(const BoardPos_t & pos, const Piece piece) const
@@ -132,57 +148,146 @@ namespace snake
         replaceWithNewPiece(context, piece, posOpt.value());
     }
 
-    void Board::replaceWithNewPiece(Context & context, const Piece piece, const BoardPos_t & pos)
+    void Board::replaceWithNewPiece(
+        Context & context,
+        const Piece piece,
+        const BoardPos_t & pos,
+        const util::SlotHandle & owner)
     {
-        M_CHECK_SS(context.layout.isPositionValid(pos), pos);
+        const std::size_t index{ cellIndex(pos) };
+        M_CHECK_SS((index < m_grid.size()), pos);
 
-        std::size_t quadIndex{ removePiece(context, pos) };
-        if (!isQuadIndexValid(quadIndex) || m_pieceVerts.empty())
+        removePiece(context, pos);
+        placePiece(context, piece, index, owner);
+    }
+
+    void Board::buildPieces(Context & context, std::initializer_list<PieceBuildList> lists)
+    {
+        // walk the lists backwards and skip any cell already claimed, so that later lists win
+        util::BitBoard claimedBits{ m_grid.size() };
+
+        for (auto listIter(std::rbegin(lists)); listIter != std::rend(lists); ++listIter)
         {
-            quadIndex = findOrMakeFreeQuadIndex();
+            for (const BoardPos_t & pos : listIter->positions)
+            {
+                const std::size_t index{ cellIndex(pos) };
+                M_CHECK_SS((index < m_grid.size()), pos);
+
+                if (claimedBits.test(index))
+                {
+                    continue;
+                }
+
+                claimedBits.set(index);
+
+                if (m_grid[index])
+                {
+                    removePiece(context, pos);
+                }
+
+                placePiece(context, listIter->piece, index);
+            }
         }
 
-        M_CHECK_SS(isQuadIndexValid(quadIndex), quadIndex);
-        M_CHECK_SS(isQuadFree(quadIndex), quadIndex);
+        M_CHECK_SS(
+            ((allPiecesCount() + freePositionCount()) == m_grid.size()),
+            "Board::buildPieces() left the board inconsistent:  allPiecesCount="
+                << allPiecesCount() << ", freePositionCount=" << freePositionCount()
+                << ", cell_count=" << m_grid.size());
+    }
 
-        setupQuad(context, quadIndex, pos, piece::toColor(piece));
-        M_CHECK_SS(!isQuadFree(quadIndex), entryToString(PosEntry(piece, quadIndex)));
+    void Board::placePiece(
+        Context & context,
+        const Piece piece,
+        const std::size_t index,
+        const util::SlotHandle & owner)
+    {
+        if (Piece::Head == piece)
+        {
+            placeHead(context, index, true);
+            return;
+        }
 
-        makePiece(context, piece, pos);
-        m_posEntryMap.erase(pos);
-        m_posEntryMap.insert({ pos, PosEntry(piece, quadIndex) });
+        // added to the tail first so the observer sees the tail it belongs to
+        if (Piece::Tail == piece)
+        {
+            m_tailPositions[owner.index].push_front(cellPosition(index));
+        }
 
-        M_CHECK_SS(entryAt(pos).has_value(), pos);
-        M_CHECK_SS((entryAt(pos)->piece_enum == piece), entryAt(pos)->piece_enum);
+        setCellEntry(context, index, PosEntry(piece, owner));
     }
 
-    std::size_t Board::removePiece(Context &, const BoardPos_t & posToRemove)
+    util::SlotHandle
+        Board::placeHead(Context & context, const std::size_t index, const bool isPlayer)
     {
-        auto erasePieceAtPosition = [&](auto & cont, const BoardPos_t & posTemp) {
-            const std::size_t countBefore{ cont.size() };
+        const BoardPos_t pos{ cellPosition(index) };
 
-            cont.erase(
-                std::remove_if(
-                    std::begin(cont),
-                    std::end(cont),
-                    [&](const auto & piece) { return (piece.position() == posTemp); }),
-                std::end(cont));
+        HeadPieces_t & headPieces{ m_headPieces.write() };
+        const util::SlotHandle handle{ headPieces.insert(HeadPiece(context, pos, isPlayer)) };
 
-            const std::size_t countAfter{ cont.size() };
+        HeadPiece * const headPiecePtr{ headPieces.find(handle) };
+        M_CHECK_SS((headPiecePtr != nullptr), "HeadPiece not found right after insert()");
+        headPiecePtr->handle(handle);
 
-            return (countBefore - countAfter);
-        };
+        // slots are re-used, so a new head might get the empty tail of an old one
+        if (m_tailPositions.size() <= handle.index)
+        {
+            m_tailPositions.resize(handle.index + 1);
+        }
 
-        auto erasePieceInContainer = [&](const Piece piece) {
+        m_tailPositions[handle.index].clear();
+
+        if (isPlayer)
+        {
+            m_playerHandle = handle;
+        }
+
+        setCellEntry(context, index, PosEntry(Piece::Head, handle));
+        return handle;
+    }
+
+    bool Board::spawnRivalSnake(Context & context)
+    {
+        const BoardPosOpt_t posOpt{ findFreeBoardPosRandom(context) };
+        if (!posOpt)
+        {
+            return false;
+        }
+
+        placeHead(context, cellIndex(posOpt.value()), false);
+        return true;
+    }
+
+    void Board::killSnake(Context & context, const util::SlotHandle & head)
+    {
+        const HeadPiece * headPtr{ m_headPieces->find(head) };
+        if (nullptr == headPtr)
+        {
+            return;
+        }
+
+        for (const BoardPos_t & pos : m_tailPositions[head.index])
+        {
+            setCellEntry(context, cellIndex(pos), std::nullopt);
+        }
+
+        m_tailPositions[head.index].clear();
+        removePiece(context, headPtr->position());
+    }
+
+    bool Board::removePiece(Context & context, const BoardPos_t & posToRemove)
+    {
+        // only heads and the tail have anything outside of m_grid to erase
+        auto erasePieceInContainer = [&](const Piece piece, const util::SlotHandle & handle) {
             // clang-format off
             switch (piece)
             {
-                case Piece::Head:   { return erasePieceAtPosition(m_headPieces, posToRemove); }
-                case Piece::Tail:   { return erasePieceAtPosition(m_tailPieces, posToRemove); }
-                case Piece::Food:   { return erasePieceAtPosition(m_foodPieces, posToRemove); }
-                case Piece::Wall:   { return erasePieceAtPosition(m_wallPieces, posToRemove); }
-                case Piece::Slow:   { return erasePieceAtPosition(m_slowPieces, posToRemove); }
-                case Piece::Shrink: { return erasePieceAtPosition(m_shrinkPieces, posToRemove); }
+                case Piece::Head:   { return std::size_t(m_headPieces.write().erase(handle)); }
+                case Piece::Tail:   { return eraseTailPiece(handle, posToRemove); }
+                case Piece::Food:
+                case Piece::Wall:
+                case Piece::Slow:
+                case Piece::Shrink: { return std::size_t(1); }
                 default: { break; }
             }
             // clang-format on
@@ -196,232 +301,288 @@ namespace snake
             throw std::runtime_error(ss.str());
         };
 
-        const auto entryToRemoveIter = m_posEntryMap.find(posToRemove);
-        if (entryToRemoveIter == std::end(m_posEntryMap))
+        const std::size_t cellIndexToRemove{ cellIndex(posToRemove) };
+        if ((cellIndexToRemove >= m_grid.size()) || !m_grid[cellIndexToRemove])
         {
-            return m_pieceVerts.size();
+            return false;
         }
 
-        const PosEntry entryToRemoveCopy{ entryToRemoveIter->second };
-        freeQuad(entryToRemoveCopy.quad_index);
+        const PosEntry entryToRemoveCopy{ m_grid[cellIndexToRemove].value() };
 
-        const std::size_t piecesErasedCount{ erasePieceInContainer(entryToRemoveCopy.piece_enum) };
+        const std::size_t piecesErasedCount{ erasePieceInContainer(
+            entryToRemoveCopy.piece_enum, entryToRemoveCopy.piece_handle) };
 
         M_CHECK_LOG_SS(
             (piecesErasedCount == 1),
             "WARNING:  posToRemove=" << posToRemove << ", erased " << piecesErasedCount);
 
-        m_posEntryMap.erase(entryToRemoveIter);
-        return entryToRemoveCopy.quad_index;
+        setCellEntry(context, cellIndexToRemove, std::nullopt);
+        return true;
     }
 
     std::size_t Board::removeAllPieces(Context & context, const Piece piece)
     {
-        const std::vector<BoardPos_t> positions = findPieces(piece);
+        // one pass over only the cells of this type, copied since setCellEntry() changes them
+        const util::BitBoard bits{ pieceBits(piece) };
+
+        bits.forEachSetBit(
+            [&](const std::size_t index) { setCellEntry(context, index, std::nullopt); });
 
-        for (const BoardPos_t & pos : positions)
+        if (Piece::Head == piece)
         {
-            removePiece(context, pos);
+            m_headPieces.write().clear();
+        }
+        else if (Piece::Tail == piece)
+        {
+            for (TailPositions_t & tailPositions : m_tailPositions)
+            {
+                tailPositions.clear();
+            }
         }
 
-        return positions.size();
+        return bits.count();
     }
 
     sf::Vector2i
         Board::move(Context & context, const BoardPos_t & fromPos, const BoardPos_t & toPos)
     {
+        const std::size_t fromIndex{ cellIndex(fromPos) };
+        const std::size_t toIndex{ cellIndex(toPos) };
+
         M_CHECK_SS(
-            entryAt(fromPos),
+            ((fromIndex < m_grid.size()) && (toIndex < m_grid.size()) && m_grid[fromIndex]),
             "fromPos=" << fromPos << ", toPos=" << toPos
-                       << " -but screw that because we're trying to move a fromPos that no piece "
-                          "is at...");
+                       << " -but either no piece is at fromPos or a position is off the board.");
 
-        const PosEntry fromEntryCopyBefore = [&]() {
-            const auto fromOrigIter{ m_posEntryMap.find(fromPos) };
+        const PosEntry fromEntryCopyBefore{ m_grid[fromIndex].value() };
 
-            M_CHECK_SS(
-                (m_posEntryMap.find(fromPos) != std::end(m_posEntryMap)),
-                "fromPos="
-                    << fromPos << ", toPos=" << toPos
-                    << " -but screw that because we're trying to move a fromPos that no piece "
-                       "is at...");
+        M_CHECK_SS(
+            (Piece::Wall != fromEntryCopyBefore.piece_enum),
+            "fromPos=" << fromPos << " is a " << fromEntryCopyBefore.piece_enum
+                       << ", which can't move.");
 
-            removePiece(context, toPos);
+        removePiece(context, toPos);
 
-            return fromOrigIter->second;
-        }();
+        // the same piece in a new cell, so the observer is told once about both
+        writeCellEntry(toIndex, fromEntryCopyBefore);
+        writeCellEntry(fromIndex, std::nullopt);
+        context.observer.onPieceMoved(fromIndex, toIndex);
 
-        m_posEntryMap.insert({ toPos, fromEntryCopyBefore });
-        m_posEntryMap.erase(fromPos);
+        return toPos;
+    }
 
-        setupQuad(context, fromEntryCopyBefore.quad_index, toPos);
+    void Board::tick(Context & context)
+    {
+        // each head keeps its own turn clock, and a tick is always shorter than a turn
+        m_headsTakingTurns.clear();
+        for (HeadPiece & headPiece : m_headPieces.write())
+        {
+            if (headPiece.advanceTurnClock())
+            {
+                m_headsTakingTurns.push_back(headPiece.handle());
+            }
+        }
+
+        if (!m_headsTakingTurns.empty())
+        {
+            takeTurns(context);
+        }
 
-        M_CHECK_SS(!entryAt(fromPos).has_value(), entryToString(entryAt(fromPos).value()));
+#if defined(SNAKE_WILL_VALIDATE_BOARD)
+        if (++m_ticksSinceValidate >= context.config.board_validate_tick_interval)
+        {
+            m_ticksSinceValidate = 0;
+            validate(context);
+        }
+#endif
+    }
 
-        M_CHECK_SS(
-            (entryAt(toPos).has_value() &&
-             (entryAt(toPos)->piece_enum == fromEntryCopyBefore.piece_enum)),
-            entryToString(entryAt(fromPos).value()));
+    std::size_t Board::ticksUntilNextTurn() const
+    {
+        std::size_t tickCount{ 0 };
+        for (const HeadPiece & headPiece : *m_headPieces)
+        {
+            const std::size_t headTickCount{ headPiece.ticksUntilTurn() };
+            if ((0 == tickCount) || (headTickCount < tickCount))
+            {
+                tickCount = headTickCount;
+            }
+        }
 
-        return toPos;
+        return tickCount;
     }
 
-    void Board::update(Context & context, const float elapsedSec)
+    void Board::skipTicks(const std::size_t tickCount)
     {
-        for (HeadPiece & piece : m_headPieces)
+        if (0 == tickCount)
         {
-            piece.update(context, elapsedSec);
+            return;
         }
 
-        for (TailPiece & piece : m_tailPieces)
+        for (HeadPiece & headPiece : m_headPieces.write())
         {
-            piece.update(context, elapsedSec);
+            headPiece.skipTicks(tickCount);
         }
+
+#if defined(SNAKE_WILL_VALIDATE_BOARD)
+        m_ticksSinceValidate += tickCount;
+#endif
     }
 
-    void Board::draw(
-        const Context & context, sf::RenderTarget & target, const sf::RenderStates & states) const
+    void Board::takeTurns(Context & context)
     {
-        // board region outline
-        sf::FloatRect outlineRect = context.layout.board_bounds_f;
-        outlineRect.left -= 1.0f;
-        outlineRect.top -= 1.0f;
-        outlineRect.width += 2.0f;
-        outlineRect.height += 2.0f;
+        if (context.game.isGameOver())
+        {
+            return;
+        }
 
-        util::drawRectangleShape(
-            target,
-            outlineRect,
-            false,
-            context.config.alt_board_background_color + sf::Color(25, 25, 25));
+        m_plannedMoves.clear();
+        for (const util::SlotHandle & handle : m_headsTakingTurns)
+        {
+            HeadPiece * headPtr{ m_headPieces.write().find(handle) };
+            if (nullptr == headPtr)
+            {
+                continue;
+            }
 
-        // draw every other cell with a slightly brighter color for a nice looking checker pattern
-        const auto & cellVerts{ context.layout.cellVerts() };
-        if (!cellVerts.empty())
+            const BoardPos_t toPos{ headPtr->planMove(context) };
+            m_plannedMoves.push_back(PlannedMove{ handle, toPos, cellIndex(toPos), false });
+        }
+
+        // sorting by the cell moved into puts all the heads moving into the same one together
+        std::sort(
+            std::begin(m_plannedMoves),
+            std::end(m_plannedMoves),
+            [](const PlannedMove & left, const PlannedMove & right) {
+                return (
+                    std::tie(left.to_index, left.head_handle.index) <
+                    std::tie(right.to_index, right.head_handle.index));
+            });
+
+        for (std::size_t i(1); i < m_plannedMoves.size(); ++i)
         {
-            target.draw(&cellVerts[0], cellVerts.size(), sf::Quads, states);
+            if (m_plannedMoves[i].to_index == m_plannedMoves[i - 1].to_index)
+            {
+                m_plannedMoves[i].is_head_on = true;
+                m_plannedMoves[i - 1].is_head_on = true;
+            }
+        }
+
+        std::size_t rivalsKilledCount{ 0 };
+        for (const PlannedMove & planned : m_plannedMoves)
+        {
+            // look up every time because killSnake() moves heads around in the SlotMap
+            HeadPiece * headPtr{ m_headPieces.write().find(planned.head_handle) };
+            if (nullptr == headPtr)
+            {
+                continue;
+            }
+
+            const PieceEnumOpt_t pieceOpt{ pieceEnumOptAt(planned.to_pos) };
+            const bool isHeadOn{ planned.is_head_on || (pieceOpt == Piece::Head) };
+
+            if (headPtr->isPlayer())
+            {
+                // Running into anything lethal costs a life without moving, so that whatever was
+                // run into stays whole.  Otherwise move() would erase a rival's tail cell first,
+                // leaving a gap in the middle of its body.
+                if (isHeadOn)
+                {
+                    context.game.handlePickup(context, planned.to_pos, Piece::Head);
+                }
+                else if (pieceOpt && piece::isLethal(pieceOpt.value()))
+                {
+                    context.game.handlePickup(context, planned.to_pos, pieceOpt.value());
+                }
+                else
+                {
+                    headPtr->takeTurn(context, planned.to_pos);
+                }
+            }
+            else if (isHeadOn || (pieceOpt && piece::isLethal(pieceOpt.value())))
+            {
+                killSnake(context, planned.head_handle);
+                ++rivalsKilledCount;
+            }
+            else
+            {
+                headPtr->takeTurn(context, planned.to_pos);
+            }
         }
 
-        if (!m_pieceVerts.empty())
+        // rivals start over somewhere else so that there are always the same count of them
+        for (std::size_t i(0); i < rivalsKilledCount; ++i)
         {
-            target.draw(&m_pieceVerts[0], m_pieceVerts.size(), sf::Quads, states);
+            if (!spawnRivalSnake(context))
+            {
+                break;
+            }
         }
     }
 
     void Board::passEventToPieces(Context & context, const sf::Event & event)
     {
         // only head pieces can respond to events
-        for (HeadPiece & piece : m_headPieces)
+        for (HeadPiece & piece : m_headPieces.write())
         {
             piece.handleEvent(context, event);
         }
     }
 
-    BoardPosVec_t Board::findAllFreePositions(const Context & context) const
+    BoardPosVec_t Board::findAllFreePositions(const Context &) const
     {
-        // start with a copy of all valid/on-board positions
-        std::set<BoardPos_t> positions{ context.layout.allValidPositions() };
+        BoardPosVec_t positions;
+        positions.reserve(m_freeCells.count);
 
-        // remove any that are alraedy occupied
-        for (const auto & [pos, entry] : m_posEntryMap)
+        for (std::size_t slot(0); slot < m_freeCells.count; ++slot)
         {
-            positions.erase(pos);
+            positions.push_back(m_freeCells.positions[slot]);
         }
 
-        BoardPosVec_t freePositions;
-        freePositions.reserve(positions.size());
-        for (const BoardPos_t & pos : positions)
-        {
-            freePositions.push_back(pos);
-        }
-
-        return freePositions;
+        return positions;
     }
 
     BoardPosOpt_t Board::findFreeBoardPosRandom(const Context & context) const
     {
-        const BoardPosVec_t positions = findAllFreePositions(context);
-
-        if (positions.empty())
+        if (0 == m_freeCells.count)
         {
             return std::nullopt;
         }
 
-        return context.random.from(positions);
+        return m_freeCells.positions[context.random.index(m_freeCells.count)];
     }
 
     BoardPosVec_t Board::findFreeBoardPosAtDistance(
         const Context & context,
         const int targetDistance,
         const DistanceRule distanceRule,
-        const std::size_t count) const
+        const std::size_t count,
+        const bool willWrap) const
     {
         BoardPosVec_t finalPositions;
 
-        // start with a copy of all valid/on-board positions
-        const BoardPosVec_t allFreePositions{ findAllFreePositions(context) };
-        if (allFreePositions.empty() || (targetDistance <= 0))
+        const HeadPiece * playerPtr{ m_headPieces->find(m_playerHandle) };
+        if ((nullptr == playerPtr) || (0 == m_freeCells.count) || (targetDistance <= 0))
         {
             return finalPositions;
         }
 
-        const BoardPos_t headPos{ m_headPieces.front().position() };
+        DistanceRingQuery query(
+            m_cellCounts, playerPtr->position(), targetDistance, distanceRule, willWrap);
 
-        std::multimap<int, BoardPos_t> targetDistPosistions;
-        for (const BoardPos_t & pos : allFreePositions)
+        // every match is collected so that the pick is from all of them and not just the rings
+        // nearest targetDistance, the rings only save looking at the cells that can't match
+        while (const BoardPosOpt_t posOpt = query.next())
         {
-            const int distanceFromTarget{ std::abs(pos.x - headPos.x) +
-                                          std::abs(pos.y - headPos.y) };
-
-            if (distanceRule == DistanceRule::Exact)
+            if (!isPieceAt(posOpt.value()))
             {
-                if (distanceFromTarget != targetDistance)
-                {
-                    continue;
-                }
+                finalPositions.push_back(posOpt.value());
             }
-
-            if (distanceRule == DistanceRule::Inside)
-            {
-                if (distanceFromTarget > targetDistance)
-                {
-                    continue;
-                }
-            }
-
-            if (distanceRule == DistanceRule::Outside)
-            {
-                if (distanceFromTarget < targetDistance)
-                {
-                    continue;
-                }
-            }
-
-            targetDistPosistions.insert({ distanceFromTarget, pos });
-        }
-
-        if (targetDistPosistions.empty())
-        {
-            return finalPositions;
         }
 
-        finalPositions.reserve(targetDistPosistions.size());
-        for (const auto & distPosPair : targetDistPosistions)
-        {
-            finalPositions.push_back(distPosPair.second);
-        }
-
-        assert(finalPositions.size() == targetDistPosistions.size());
-
-        std::sort(std::begin(finalPositions), std::end(finalPositions));
-
-        finalPositions.erase(
-            std::unique(std::begin(finalPositions), std::end(finalPositions)),
-            std::end(finalPositions));
-
         context.random.shuffle(finalPositions);
 
-        if ((count > 0) && finalPositions.size() > count)
+        if ((count > 0) && (finalPositions.size() > count))
         {
             finalPositions.resize(count);
         }
@@ -430,151 +591,152 @@ namespace snake
     }
 
     BoardPosVec_t Board::findFreeBoardPosAroundBody(
-        const Context & context, const int distanceMin, const int, const std::size_t count) const
+        const Context & context,
+        const int distanceFromWall,
+        const int distanceFromBody,
+        const std::size_t count) const
     {
-        assert(distanceMin > 0);
+        BoardPosVec_t positions;
 
-        const std::size_t reserveCount{ static_cast<std::size_t>(context.layout.cell_count_total) };
+        if ((distanceFromBody <= 0) || m_grid.empty())
+        {
+            return positions;
+        }
 
-        BoardPosVec_t innerPositions;
-        innerPositions.reserve(reserveCount);
+        util::BitBoard freeBits{ m_grid.size() };
+        for (std::size_t slot(0); slot < m_freeCells.count; ++slot)
+        {
+            freeBits.set(cellIndex(m_freeCells.positions[slot]));
+        }
+
+        util::BitBoard reachedBits{ pieceBits(Piece::Head) | pieceBits(Piece::Tail) };
+        util::BitBoard ringBits{ reachedBits };
 
-        BoardPosVec_t outerPositions;
-        outerPositions.reserve(reserveCount);
+        // each pass grows into free cells only, so the last ring is exactly distanceFromBody away
+        for (int distance(1); distance <= distanceFromBody; ++distance)
+        {
+            ringBits = dilate(reachedBits);
+            ringBits &= freeBits;
+            ringBits.andNot(reachedBits);
 
-        auto isPosValidAndFree = [&](const BoardPos_t & pos) {
-            if (!context.layout.isPositionValid(pos) || isPieceAt(pos))
+            if (ringBits.none())
             {
-                return false;
+                return positions;
             }
 
-            return (
-                std::find(std::begin(innerPositions), std::end(innerPositions), pos) ==
-                std::end(innerPositions));
-        };
-
-        // start with inner positions as all the body positions
-        assert(m_headPieces.size() >= 1);
-        innerPositions.push_back(m_headPieces.front().position());
-
-        for (const TailPiece & piece : m_tailPieces)
-        {
-            innerPositions.push_back(piece.position());
+            reachedBits |= ringBits;
         }
 
-        // find free positions around the inner positions
-        // minCount starts at one because inner positions already filled with valid body positions
-        int minCount(1);
-        for (; minCount <= distanceMin; ++minCount)
+        if (distanceFromWall > 0)
         {
-            for (const BoardPos_t & bodyPos : innerPositions)
+            util::BitBoard nearWallBits{ pieceBits(Piece::Wall) };
+            for (int distance(1); distance < distanceFromWall; ++distance)
             {
-                for (const sf::Vector2i & offset : surroundingsPositionOffsets)
-                {
-                    const BoardPos_t pos(bodyPos + offset);
-
-                    if (isPosValidAndFree(pos))
-                    {
-                        outerPositions.push_back(pos);
-                    }
-                }
+                nearWallBits = dilate(nearWallBits);
             }
 
-            // copy all outer to inner to outerPositions and remove any duplicates
-            std::copy(
-                std::begin(outerPositions),
-                std::end(outerPositions),
-                std::back_inserter(innerPositions));
-
-            std::sort(std::begin(innerPositions), std::end(innerPositions));
+            ringBits.andNot(nearWallBits);
+        }
 
-            innerPositions.erase(
-                std::unique(std::begin(innerPositions), std::end(innerPositions)),
-                std::end(innerPositions));
+        positions.reserve(ringBits.count());
+        ringBits.forEachSetBit(
+            [&](const std::size_t index) { positions.push_back(cellPosition(index)); });
 
-            if (minCount < distanceMin)
-            {
-                outerPositions.clear();
-            }
-        }
+        context.random.shuffle(positions);
 
-        if ((count > 0) && outerPositions.size() > count)
+        if ((count > 0) && (positions.size() > count))
         {
-            outerPositions.resize(count);
+            positions.resize(count);
         }
 
-        return outerPositions;
+        return positions;
     }
 
-    void Board::colorQuad(const BoardPos_t & pos, const sf::Color & color)
+    util::BitBoard Board::dilate(const util::BitBoard & bits) const
     {
-        const PosEntryOpt_t entryOpt{ entryAt(pos) };
-        if (!entryOpt)
-        {
-            return;
-        }
+        const std::size_t rowLength{ static_cast<std::size_t>(m_cellCounts.x) };
 
-        colorQuad(entryOpt->quad_index, color);
+        util::BitBoard grown{ bits };
+        grown |= ((bits << 1) & m_notFirstColumnBits);
+        grown |= ((bits >> 1) & m_notLastColumnBits);
+
+        util::BitBoard rowsGrown{ grown };
+        rowsGrown |= (grown << rowLength);
+        rowsGrown |= (grown >> rowLength);
+        return rowsGrown;
     }
 
     const PosEntryOpt_t Board::entryAt(const BoardPos_t & pos) const
     {
-        const auto foundIter{ m_posEntryMap.find(pos) };
-        if (foundIter == std::end(m_posEntryMap))
+        const std::size_t index{ cellIndex(pos) };
+        if (index >= m_grid.size())
         {
             return std::nullopt;
         }
         else
         {
-            return foundIter->second;
+            return m_grid[index];
         }
     }
 
-    void Board::reColorTailPieces(Context & context)
+    const TailPositions_t & Board::playerTailPositions() const
     {
-        float index{ 0.0f };
-        const float count{ static_cast<float>(m_tailPieces.size()) };
-        for (auto iter(std::begin(m_tailPieces)); iter != std::end(m_tailPieces); ++iter)
+        static const TailPositions_t emptyTailPositions;
+
+        if (m_playerHandle.index < m_tailPositions.size())
         {
-            iter->color(
-                context,
-                util::colorBlend((index / count), TailPiece::m_colorLight, TailPiece::m_colorDark));
+            return m_tailPositions[m_playerHandle.index];
+        }
+
+        return emptyTailPositions;
+    }
 
-            index += 1.0f;
+    const BoardPosVec_t & Board::foodPositions() const
+    {
+        if (m_isFoodPositionsStale)
+        {
+            m_foodPositions = findPieces(Piece::Food);
+            m_isFoodPositionsStale = false;
         }
+
+        return m_foodPositions;
     }
 
     std::size_t Board::allPiecesCount() const
     {
-        return (
-            m_headPieces.size() + m_tailPieces.size() + m_foodPieces.size() + m_slowPieces.size() +
-            m_wallPieces.size() + m_shrinkPieces.size());
+        return (m_grid.size() - m_freeCells.count);
     }
 
     std::vector<BoardPos_t> Board::findPieces(const Piece piece) const
     {
+        const util::BitBoard & bits{ pieceBits(piece) };
+
         std::vector<BoardPos_t> positions;
-        positions.reserve(allPiecesCount());
+        positions.reserve(bits.count());
 
-        for (const auto & [pos, entry] : m_posEntryMap)
-        {
-            if (piece == entry.piece_enum)
-            {
-                positions.push_back(pos);
-            }
-        }
+        bits.forEachSetBit(
+            [&](const std::size_t index) { positions.push_back(cellPosition(index)); });
 
         return positions;
     }
 
     const AdjacentInfoOpt_t
-        Board::adjacentInfoOpt(const BoardPos_t & centerPos, const sf::Keyboard::Key dir) const
+        Board::adjacentInfoOpt(
+            const Context & context,
+            const BoardPos_t & centerPos,
+            const sf::Keyboard::Key dir) const
     {
-        const BoardPos_t adjPos{ keys::move(centerPos, dir) };
-        const auto enumOpt{ pieceEnumOptAt(adjPos) };
-        if (enumOpt)
+        const std::size_t centerIndex{ cellIndex(centerPos) };
+        if (centerIndex >= m_grid.size())
+        {
+            return std::nullopt;
+        }
+
+        const std::size_t adjIndex{ context.layout.neighborIndex(centerIndex, dir) };
+        const PosEntryOpt_t & entryOpt{ m_grid[adjIndex] };
+        if (entryOpt)
         {
-            return AdjacentInfo{ enumOpt.value(), adjPos, dir };
+            return AdjacentInfo{ entryOpt->piece_enum, cellPosition(adjIndex), dir };
         }
         else
         {
@@ -582,104 +744,265 @@ namespace snake
         }
     }
 
-    const Surroundings Board::surroundings(const BoardPos_t & centerPos) const
+    const Surroundings
+        Board::surroundings(const Context & context, const BoardPos_t & centerPos) const
     {
         Surroundings surr(centerPos);
 
-        // clang-format off
-            if (const AdjacentInfoOpt_t opt{ adjacentInfoOpt(centerPos, sf::Keyboard::Up) };    opt) surr.adjacents.push_back(opt.value());
-            if (const AdjacentInfoOpt_t opt{ adjacentInfoOpt(centerPos, sf::Keyboard::Down) };  opt) surr.adjacents.push_back(opt.value());
-            if (const AdjacentInfoOpt_t opt{ adjacentInfoOpt(centerPos, sf::Keyboard::Left) };  opt) surr.adjacents.push_back(opt.value());
-            if (const AdjacentInfoOpt_t opt{ adjacentInfoOpt(centerPos, sf::Keyboard::Right) }; opt) surr.adjacents.push_back(opt.value());
-        // clang-format on
+        const std::size_t centerIndex{ cellIndex(centerPos) };
+        if (centerIndex >= m_grid.size())
+        {
+            return surr;
+        }
+
+        const Layout::Neighbors_t & neighbors{ context.layout.neighbors(centerIndex) };
+        for (std::size_t i(0); i < Layout::neighbor4_count; ++i)
+        {
+            const PosEntryOpt_t & entryOpt{ m_grid[neighbors[i]] };
+            if (entryOpt)
+            {
+                surr.add(
+                    { entryOpt->piece_enum, cellPosition(neighbors[i]), Layout::neighbor_dirs[i] });
+            }
+        }
 
         return surr;
     }
 
     void Board::shrinkTail(Context & context)
     {
-        // stop growing the tail
-        for (HeadPiece & headPiece : m_headPieces)
+        HeadPiece * playerPtr{ m_headPieces.write().find(m_playerHandle) };
+        if (nullptr == playerPtr)
         {
-            headPiece.resetTailGrowCounter();
+            return;
         }
 
-        std::size_t newTailSize = (m_tailPieces.size() / 2);
+        // stop growing the tail
+        playerPtr->resetTailGrowCounter();
+
+        const TailPositions_t & tailPositions{ playerTailPositions() };
+        std::size_t newTailSize = (tailPositions.size() / 2);
 
         if (newTailSize < context.game.level().tail_start_length)
         {
             newTailSize = context.game.level().tail_start_length;
         }
 
-        while (m_tailPieces.size() > newTailSize)
+        // free every cell being cut off and then drop them all at once
+        for (std::size_t index(newTailSize); index < tailPositions.size(); ++index)
         {
-            removePiece(context, findLastTailPiecePos());
+            setCellEntry(context, cellIndex(tailPositions[index]), std::nullopt);
         }
 
-        reColorTailPieces(context);
+        m_tailPositions[m_playerHandle.index].truncate(newTailSize);
+
+        context.observer.onPlayerTailChanged();
     }
 
-    PieceBase & Board::makePiece(Context & context, const Piece piece, const BoardPos_t & pos)
+    void Board::validate(const Context & context) const
     {
-        switch (piece)
+        const std::size_t cellCount{ m_grid.size() };
+
+        M_CHECK_SS(
+            ((m_cellCounts == context.layout.cell_counts) &&
+             (cellCount == context.layout.cell_count_total_st) &&
+             (m_freeCells.slots.size() == cellCount)),
+            "cell_counts=" << m_cellCounts << ", layout.cell_counts=" << context.layout.cell_counts
+                           << ", grid_size=" << cellCount
+                           << ", free_slots_size=" << m_freeCells.slots.size());
+
+        // every cell is either in the free index or holds one piece
+        std::size_t occupiedCount{ 0 };
+        for (std::size_t index(0); index < cellCount; ++index)
         {
-            case Piece::Head: return m_headPieces.emplace_back(HeadPiece(context, pos));
-            case Piece::Tail: return m_tailPieces.emplace_front(TailPiece(context, pos)); //-V525
-            case Piece::Food: return m_foodPieces.emplace_back(FoodPiece(context, pos));
-            case Piece::Wall: return m_wallPieces.emplace_back(WallPiece(context, pos));
-            case Piece::Slow: return m_slowPieces.emplace_back(SlowPiece(context, pos));
-            case Piece::Shrink: return m_shrinkPieces.emplace_back(ShrinkPiece(context, pos));
-            default: break;
+            const PosEntryOpt_t & entryOpt{ m_grid[index] };
+            const BoardPos_t pos{ cellPosition(index) };
+
+            std::size_t bitsSetCount{ 0 };
+            for (const util::BitBoard & bits : m_pieceBits)
+            {
+                bitsSetCount += static_cast<std::size_t>(bits.test(index));
+            }
+
+            if (!entryOpt)
+            {
+                M_CHECK_SS(
+                    ((m_freeCells.slots[index] < m_freeCells.count) &&
+                     (m_freeCells.positions[m_freeCells.slots[index]] == pos) &&
+                     (0 == bitsSetCount)),
+                    "free cell " << pos << " is missing from the free index or has bits set");
+
+                continue;
+            }
+
+            ++occupiedCount;
+            const PosEntry & entry{ entryOpt.value() };
+
+            M_CHECK_SS(
+                ((m_freeCells.slots[index] == cellCount) && (1 == bitsSetCount) &&
+                 pieceBits(entry.piece_enum).test(index)),
+                "occupied cell " << pos << " is in the free index or has the wrong bits set:  "
+                                 << entryToString(entry));
+
+            if (Piece::Head == entry.piece_enum)
+            {
+                const HeadPiece * headPtr{ m_headPieces->find(entry.piece_handle) };
+
+                M_CHECK_SS(
+                    ((nullptr != headPtr) && (headPtr->position() == pos)),
+                    "the head handle at " << pos << " is stale:  " << entryToString(entry));
+            }
         }
 
-        std::ostringstream ss;
+        M_CHECK_SS(
+            ((occupiedCount + m_freeCells.count) == cellCount),
+            "occupied_count=" << occupiedCount << ", free_count=" << m_freeCells.count
+                              << ", cell_count=" << cellCount);
 
-        ss << "Board::makePiece(piece=" << piece << ", pos=" << pos
-           << ") -but that piece enum is unknown.";
+        // the heads and the tails hold exactly the ones on the grid
+        std::size_t tailCount{ 0 };
+        for (const TailPositions_t & tailPositions : m_tailPositions)
+        {
+            tailCount += tailPositions.size();
+        }
+
+        M_CHECK_SS(
+            ((m_headPieces->size() == countPieces(Piece::Head)) &&
+             (tailCount == countPieces(Piece::Tail))),
+            "head_count=" << m_headPieces->size() << ", head_bit_count="
+                          << countPieces(Piece::Head) << ", tail_count=" << tailCount
+                          << ", tail_bit_count=" << countPieces(Piece::Tail));
+
+        for (const HeadPiece & headPiece : *m_headPieces)
+        {
+            const std::size_t index{ cellIndex(headPiece.position()) };
+
+            M_CHECK_SS(
+                ((index < cellCount) && isPiece(headPiece.position(), Piece::Head)),
+                "head at " << headPiece.position() << " is not on the grid there");
+        }
+
+        util::BitBoard tailBits{ cellCount };
+        for (std::size_t slotIndex(0); slotIndex < m_tailPositions.size(); ++slotIndex)
+        {
+            for (const BoardPos_t & pos : m_tailPositions[slotIndex])
+            {
+                const std::size_t index{ cellIndex(pos) };
+
+                M_CHECK_SS(
+                    ((index < cellCount) && isPiece(pos, Piece::Tail) && !tailBits.test(index) &&
+                     (m_grid[index]->piece_handle.index == slotIndex) &&
+                     m_headPieces->contains(m_grid[index]->piece_handle)),
+                    "tail at " << pos << " is not on the grid there, is in a tail twice, or "
+                               << "belongs to a head that is gone");
 
-        throw std::runtime_error(ss.str());
+                tailBits.set(index);
+            }
+        }
     }
 
-    std::size_t Board::findOrMakeFreeQuadIndex()
+    BoardSnapshot Board::snapshot() const
     {
-        if (m_pieceVerts.size() >= util::verts_per_quad)
+        BoardSnapshot snap;
+        snap.cell_counts = m_cellCounts;
+        snap.grid = m_grid;
+        snap.head_pieces = m_headPieces;
+        snap.tail_positions = m_tailPositions;
+        snap.player_handle = m_playerHandle;
+        snap.free_cells = m_freeCells;
+        return snap;
+    }
+
+    void Board::restore(Context & context, const BoardSnapshot & snap)
+    {
+        M_CHECK_SS(
+            ((snap.cell_counts == m_cellCounts) && (snap.grid.size() == m_grid.size())),
+            "Board::restore() given a snapshot of a different sized board: snapshot="
+                << snap.cell_counts << ", board=" << m_cellCounts);
+
+        // swapped in first because the observer looks up the heads from the snapshot
+        m_headPieces = snap.head_pieces;
+        m_tailPositions = snap.tail_positions;
+        m_playerHandle = snap.player_handle;
+
+        // only chunks that either side wrote to since the snapshot was taken can be different
+        for (std::size_t chunkIndex(0); chunkIndex < m_grid.chunkCount(); ++chunkIndex)
         {
-            for (std::size_t index(0); index < (m_pieceVerts.size() - util::verts_per_quad);
-                 index += util::verts_per_quad)
+            if (m_grid.isChunkSharedWith(snap.grid, chunkIndex))
+            {
+                continue;
+            }
+
+            const std::size_t first{ chunkIndex * PosEntryGrid_t::chunk_size };
+            const std::size_t last{ std::min(m_grid.size(), (first + PosEntryGrid_t::chunk_size)) };
+
+            for (std::size_t index(first); index < last; ++index)
             {
-                if (isQuadFree(index))
+                const PosEntryOpt_t currentOpt{ m_grid[index] };
+                const PosEntryOpt_t & wantedOpt{ snap.grid[index] };
+
+                if (currentOpt.has_value() == wantedOpt.has_value())
                 {
-                    return index;
+                    if (!currentOpt ||
+                        ((currentOpt->piece_enum == wantedOpt->piece_enum) &&
+                         (currentOpt->piece_handle == wantedOpt->piece_handle)))
+                    {
+                        continue;
+                    }
                 }
+
+                setCellEntry(context, index, wantedOpt);
             }
         }
 
-        const std::size_t freeQuadIndex{ m_pieceVerts.size() };
-        m_pieceVerts.resize((m_pieceVerts.size() + util::verts_per_quad), m_freeQuadVertex);
-        return freeQuadIndex;
+        // The cells above were freed and taken in a different order than they were the first
+        // time, so the free list has the right cells but not in the same order.  Swapping the
+        // snapshot's back in means findFreeBoardPosRandom() picks the same cells it did then.
+        m_freeCells = snap.free_cells;
+
+        context.observer.onBoardRestored();
     }
 
-    std::string Board::entryToString(const PosEntry & entry) const
+    std::size_t Board::eraseTailPiece(const util::SlotHandle & owner, const BoardPos_t & pos)
     {
-        std::ostringstream ss;
+        if ((owner.index >= m_tailPositions.size()) || m_tailPositions[owner.index].empty())
+        {
+            return 0;
+        }
 
-        ss << "PosEntry(" << entry.piece_enum;
-        ss << ", #" << entry.quad_index;
-        ss << "/%4=" << (entry.quad_index % util::verts_per_quad);
-        ss << "/Q#" << (entry.quad_index / util::verts_per_quad);
+        TailPositions_t & tailPositions{ m_tailPositions[owner.index] };
 
-        for (std::size_t i(0); i < util::verts_per_quad; ++i)
+        if (tailPositions.back() == pos)
         {
-            ss << "\n\t" << i << "/" << (entry.quad_index + i) << ":\t"
-               << m_pieceVerts.at(entry.quad_index + i);
+            tailPositions.pop_back();
+            return 1;
         }
 
+        for (std::size_t index(0); index < tailPositions.size(); ++index)
+        {
+            if (tailPositions[index] == pos)
+            {
+                tailPositions.erase(index);
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    std::string Board::entryToString(const PosEntry & entry) const
+    {
+        std::ostringstream ss;
+
+        ss << "PosEntry(" << entry.piece_enum;
+        ss << ", slot=" << entry.piece_handle.index;
+        ss << "/gen=" << entry.piece_handle.generation;
+
         ss << "\n\t-";
 
-        for (const auto & piece : m_headPieces)
+        for (const auto & piece : *m_headPieces)
         {
-            ss << "\n\t" << piece.piece() << ", pos=" << piece.position()
-               << ", color=" << piece.color();
+            ss << "\n\t" << piece.piece() << ", pos=" << piece.position();
         }
 
         ss << ")";
@@ -697,91 +1020,85 @@ namespace snake
             ss << "(ERROR:PIECE_" << int(entry.piece_enum) << "_HAS_EMPTY_NAME)";
         }
 
-        const bool isMultipleOfFour{ (entry.quad_index % util::verts_per_quad) == 0 };
-        if (!isMultipleOfFour)
-        {
-            ss << "(ERROR:INDEX_" << entry.quad_index << "_NOT_MULT_OF_4)";
-        }
+        return ss.str();
+    }
 
-        const bool isIndexInRange{ (entry.quad_index + util::verts_per_quad) <=
-                                   m_pieceVerts.size() };
-        if (!isIndexInRange)
+    std::size_t Board::cellIndex(const BoardPos_t & pos) const
+    {
+        if ((pos.x < 0) || (pos.y < 0) || (pos.x >= m_cellCounts.x) || (pos.y >= m_cellCounts.y))
         {
-            ss << "(ERROR:INDEX_" << entry.quad_index
-               << "_OUT_OF_RANGE_WITH_VERT_VEC_SIZE=" << m_pieceVerts.size() << ")";
+            return m_grid.size();
         }
 
-        if (isQuadIndexValid(entry.quad_index))
+        return static_cast<std::size_t>((pos.y * m_cellCounts.x) + pos.x);
+    }
+
+    BoardPos_t Board::cellPosition(const std::size_t index) const
+    {
+        const int indexInt{ static_cast<int>(index) };
+        return { (indexInt % m_cellCounts.x), (indexInt / m_cellCounts.x) };
+    }
+
+    void Board::setCellEntry(
+        Context & context, const std::size_t index, const PosEntryOpt_t & entryOpt)
+    {
+        const PieceEnumOpt_t pieceBefore{ m_grid[index] ? PieceEnumOpt_t(m_grid[index]->piece_enum)
+                                                        : std::nullopt };
+
+        writeCellEntry(index, entryOpt);
+
+        if (entryOpt)
         {
-            if (isQuadFree(entry.quad_index))
-            {
-                ss << "(COLORS_INVALID_FREE/TRANSPARENT)";
-            }
+            context.observer.onCellChanged(
+                index, pieceBefore, entryOpt->piece_enum, entryOpt->piece_handle);
         }
         else
         {
-            ss << "(INDEX_IS_INVALID:vert_vec.size=" << m_pieceVerts.size() << ")";
+            context.observer.onCellChanged(index, pieceBefore, std::nullopt, {});
         }
-
-        return ss.str();
     }
 
-    void Board::setupQuad(
-        Context & context,
-        const std::size_t quadIndex,
-        const BoardPos_t & pos,
-        const sf::Color & color)
+    void Board::writeCellEntry(const std::size_t index, const PosEntryOpt_t & entryOpt)
     {
-        M_CHECK_SS(isQuadIndexValid(quadIndex), quadIndex);
-
-        const sf::FloatRect rect{ context.layout.cellBounds(pos) };
-        const sf::Vector2f rectPos{ rect.left, rect.top };
+        const bool wasFree{ !m_grid[index].has_value() };
 
-        if (color != m_freeVertColor)
+        const bool wasFood{ !wasFree && (Piece::Food == m_grid[index]->piece_enum) };
+        const bool willBeFood{ entryOpt && (Piece::Food == entryOpt->piece_enum) };
+        if (wasFood || willBeFood)
         {
-            colorQuad(quadIndex, color);
+            m_isFoodPositionsStale = true;
         }
 
-        // clang-format off
-        m_pieceVerts[quadIndex + 0].position = { rectPos + sf::Vector2f(      0.0f,        0.0f) };
-        m_pieceVerts[quadIndex + 1].position = { rectPos + sf::Vector2f(rect.width,        0.0f) };
-        m_pieceVerts[quadIndex + 2].position = { rectPos + sf::Vector2f(rect.width, rect.height) };
-        m_pieceVerts[quadIndex + 3].position = { rectPos + sf::Vector2f(      0.0f, rect.height) };
-        // clang-format on
-    }
+        if (!wasFree)
+        {
+            m_pieceBits[piece::toIndex(m_grid[index]->piece_enum)].clear(index);
+        }
 
-    void Board::freeQuad(const std::size_t quadIndex) { colorQuad(quadIndex, m_freeVertColor); }
+        if (entryOpt)
+        {
+            m_pieceBits[piece::toIndex(entryOpt->piece_enum)].set(index);
+        }
 
-    void Board::colorQuad(const std::size_t quadIndex, const sf::Color & color)
-    {
-        M_CHECK_SS(isQuadIndexValid(quadIndex), quadIndex);
+        m_grid.set(index, entryOpt);
 
-        m_pieceVerts[quadIndex + 0].color = color;
-        m_pieceVerts[quadIndex + 1].color = color;
-        m_pieceVerts[quadIndex + 2].color = color;
-        m_pieceVerts[quadIndex + 3].color = color;
-    }
-
-    bool Board::isQuadIndexValid(const std::size_t quadIndex) const
-    {
-        const bool isMultipleOfFour{ (quadIndex % util::verts_per_quad) == 0 };
-        const bool isIndexInRange{ (quadIndex + util::verts_per_quad) <= m_pieceVerts.size() };
-        return (isMultipleOfFour && isIndexInRange);
-    }
+        if (wasFree && entryOpt)
+        {
+            // swap-remove from the free list and patch the slot of whatever got swapped in
+            const std::size_t slot{ m_freeCells.slots[index] };
+            const BoardPos_t lastPos{ m_freeCells.positions[m_freeCells.count - 1] };
 
-    bool Board::isQuadFree(const std::size_t quadIndex) const
-    {
-        M_CHECK_SS(isQuadIndexValid(quadIndex), quadIndex);
+            m_freeCells.positions.set(slot, lastPos);
+            m_freeCells.slots.set(cellIndex(lastPos), slot);
 
-        for (std::size_t i(0); ((i < util::verts_per_quad) && (i < m_pieceVerts.size())); ++i)
+            --m_freeCells.count;
+            m_freeCells.slots.set(index, m_grid.size());
+        }
+        else if (!wasFree && !entryOpt)
         {
-            if (m_pieceVerts[quadIndex + i].color != m_freeVertColor)
-            {
-                return false;
-            }
+            m_freeCells.slots.set(index, m_freeCells.count);
+            m_freeCells.positions.set(m_freeCells.count, cellPosition(index));
+            ++m_freeCells.count;
         }
-
-        return true;
     }
 
 } // namespace snake
@@ -4,53 +4,94 @@
 // board.hpp
 //
 #include "adjacent.hpp"
+#include "bit-board.hpp"
 #include "check-macros.hpp"
 #include "common-types.hpp"
+#include "copy-on-write.hpp"
+#include "distance-rings.hpp"
 #include "keys.hpp"
 #include "pieces.hpp"
+#include "slot-map.hpp"
 
 #include <array>
-#include <list>
+#include <initializer_list>
 #include <optional>
 #include <tuple>
+#include <utility>
 #include <vector>
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/Event.hpp>
 
 //
 
 namespace snake
 {
-    enum class DistanceRule
-    {
-        Exact,
-        Inside,
-        Outside
-    };
-
-    //
-
     struct PosEntry
     {
-        PosEntry(const Piece piece, const std::size_t quadIndex) noexcept
+        explicit PosEntry(const Piece piece, const util::SlotHandle handle = {}) noexcept
             : piece_enum(piece)
-            , quad_index(quadIndex)
+            , piece_handle(handle)
         {}
 
         Piece piece_enum;
-        std::size_t quad_index;
+        util::SlotHandle piece_handle; // heads hold their own, tails hold their head's
     };
 
     using PosEntryOpt_t = std::optional<PosEntry>;
+    using PosEntryGrid_t = util::CowChunkedVector<PosEntryOpt_t>;
+
+    using HeadPieces_t = util::SlotMap<HeadPiece>;
+    using TailPositions_t = util::CowChunkedRing<BoardPos_t>; // front is next to the head
+
+    // Every unoccupied cell in no particular order in the first count positions, removed from
+    // by swapping with the last one, and slots holds the index into positions for every cell
+    // (or the cell count if occupied).  Both are chunked like the grid so snapshots share them.
+    struct FreeCells
+    {
+        util::CowChunkedVector<BoardPos_t> positions;
+        util::CowChunkedVector<std::size_t> slots;
+        std::size_t count{ 0 };
+    };
+
+    //
+
+    // Everything needed to put the pieces back where they were, and the free cells in the
+    // order they were in.  Making one only copies pointers, because the grid chunks, heads,
+    // tails, and free cells are shared with the Board until either side changes them.
+    // Nothing drawn is saved since restore() tells the observer about every cell that
+    // changed.  Only valid for the Board that made it, and only until Board::reset().
+    struct BoardSnapshot
+    {
+        sf::Vector2i cell_counts{ 0, 0 };
+        PosEntryGrid_t grid;
+        util::CowPtr<HeadPieces_t> head_pieces;
+        std::vector<TailPositions_t> tail_positions;
+        util::SlotHandle player_handle;
+
+        // kept so that the same seed places the same random pieces after a restore
+        FreeCells free_cells;
+    };
 
     //
 
+    // one Piece and every position it should be placed at, see Board::buildPieces()
+    struct PieceBuildList
+    {
+        Piece piece;
+        const BoardPosVec_t & positions;
+    };
+
+    //
+
+    // Where every piece is and the rules for moving them, with nothing to draw.  Every change
+    // to a cell is passed on to Context::observer, which is how BoardView keeps its quads.
     class Board
     {
       public:
         Board() = default;
 
-        void reset();
+        void reset(const Layout & layout);
 
         void loadMap(Context & context, const bool willLoadNewMap);
 
@@ -59,99 +100,208 @@ namespace snake
         PieceEnumOpt_t pieceEnumOptAt(const BoardPos_t & pos) const;
 
         void addNewPieceAtRandomFreePos(Context &, const Piece piece);
-        void replaceWithNewPiece(Context &, const Piece piece, const BoardPos_t & pos);
 
-        // returns m_pieceVerts index of the piece erased, otherwise m_pieceVerts.size()
-        std::size_t removePiece(Context &, const BoardPos_t & pos);
+        // tails need the handle of the head they belong to, everything else ignores owner
+        void replaceWithNewPiece(
+            Context &,
+            const Piece piece,
+            const BoardPos_t & pos,
+            const util::SlotHandle & owner = {});
+
+        // Places many pieces in one pass for loading levels.  Skips the per-piece checks that
+        // replaceWithNewPiece() makes and validates the whole board once at the end instead.
+        // Later lists win when they share a position, the same as calling
+        // replaceWithNewPiece() in order.
+        void buildPieces(Context &, std::initializer_list<PieceBuildList> lists);
+
+        // returns false if there was nothing at pos to remove
+        bool removePiece(Context &, const BoardPos_t & pos);
 
         // returns the count of pieces removed
         std::size_t removeAllPieces(Context &, const Piece piece);
 
         sf::Vector2i move(Context &, const BoardPos_t & fromPos, const BoardPos_t & toPos);
 
-        void update(Context &, const float elapsedSec);
-        void draw(const Context & context, sf::RenderTarget &, const sf::RenderStates &) const;
+        // Advances one fixed simulation tick.  Only heads take turns, so this costs the same no
+        // matter how many other pieces, and all the heads due on this tick move together, see
+        // takeTurns().
+        void tick(Context & context);
+
+        // the fewest tick() calls before any head takes a turn, or zero if there are no heads
+        std::size_t ticksUntilNextTurn() const;
+
+        // the same as that many tick() calls where no head is due, see ticksUntilNextTurn()
+        void skipTicks(const std::size_t tickCount);
+
         void passEventToPieces(Context &, const sf::Event & event);
 
         BoardPosVec_t findAllFreePositions(const Context & context) const;
+        std::size_t freePositionCount() const { return m_freeCells.count; }
 
         BoardPosOpt_t findFreeBoardPosRandom(const Context & context) const;
 
+        // Picks count (zero means all) uniformly at random from every free cell that is
+        // targetDistance from the player's head by distanceRule, walking only the distance rings
+        // that can match.  It is the player's head because that was the only head there was
+        // before rival snakes, and with no player nothing is found.
         BoardPosVec_t findFreeBoardPosAtDistance(
             const Context & context,
             const int targetDistance,
             const DistanceRule distanceRule,
-            const std::size_t count) const;
+            const std::size_t count,
+            const bool willWrap = false) const;
 
+        // free cells exactly distanceFromBody steps (counting diagonals) away from the snake,
+        // reached only through free cells, that are also at least distanceFromWall steps away
+        // from every wall (zero or less means walls are ignored), count of zero means find all
         BoardPosVec_t findFreeBoardPosAroundBody(
             const Context & context,
             const int distanceFromWall,
             const int distanceFromBody,
             const std::size_t count) const;
 
-        void colorQuad(const BoardPos_t & pos, const sf::Color & color);
         const PosEntryOpt_t entryAt(const BoardPos_t & pos) const;
 
         std::string entryToString(const PosEntry & entry) const;
 
-        BoardPos_t findLastTailPiecePos() const { return m_tailPieces.back().position(); }
+        BoardPos_t findLastTailPiecePos(const util::SlotHandle & head) const
+        {
+            return m_tailPositions[head.index].back();
+        }
+
+        // from the piece next to the head to the end, empty if there is no player
+        const TailPositions_t & playerTailPositions() const;
+        const util::SlotHandle & playerHandle() const { return m_playerHandle; }
+        const HeadPieces_t & headPieces() const { return *m_headPieces; }
+
+        // the same vector until a Food piece is added or removed
+        const BoardPosVec_t & foodPositions() const;
 
-        void reColorTailPieces(Context & context);
+        // the player and all the rivals
+        std::size_t snakeCount() const { return m_headPieces->size(); }
 
         std::size_t allPiecesCount() const;
 
         std::vector<BoardPos_t> findPieces(const Piece piece) const;
 
-        std::size_t countPieces(const Piece piece) const { return findPieces(piece).size(); }
+        std::size_t countPieces(const Piece piece) const
+        {
+            return m_pieceBits[piece::toIndex(piece)].count();
+        }
 
-        const AdjacentInfoOpt_t
-            adjacentInfoOpt(const BoardPos_t & centerPos, const sf::Keyboard::Key dir) const;
+        // one bit per m_grid cell that is set wherever that piece is
+        const util::BitBoard & pieceBits(const Piece piece) const
+        {
+            return m_pieceBits[piece::toIndex(piece)];
+        }
 
-        const Surroundings surroundings(const BoardPos_t & centerPos) const;
+        // both wrap around the board edges, and both are only a few array loads using the
+        // Layout::neighbors() table
+        const AdjacentInfoOpt_t adjacentInfoOpt(
+            const Context & context,
+            const BoardPos_t & centerPos,
+            const sf::Keyboard::Key dir) const;
+
+        const Surroundings
+            surroundings(const Context & context, const BoardPos_t & centerPos) const;
 
         void shrinkTail(Context & context);
 
+        // O(chunks) to make and O(changed chunks) to restore, and after either one every cell
+        // that changes clones at most one chunk of the grid, the free cells, and its tail, plus
+        // the heads once since they are not chunked
+        BoardSnapshot snapshot() const;
+        void restore(Context & context, const BoardSnapshot & snapshot);
+
+        // Cross-checks the grid against the heads, tail, free index, and bitboards and fails an
+        // M_CHECK on the first mismatch.  This is O(cells) so it replaces the per-move checks,
+        // and tick() only calls it when built with BOARD_VALIDATION, see BoardView::validate().
+        void validate(const Context & context) const;
+
       private:
         void loadMap_New(Context & context);
         void loadMap_Same(Context & context);
+        void placeLevelPieces(Context & context);
+
+        // no checks and the cell must be free, use replaceWithNewPiece() or buildPieces()
+        void placePiece(
+            Context &,
+            const Piece piece,
+            const std::size_t index,
+            const util::SlotHandle & owner = {});
 
-        PieceBase & makePiece(Context &, const Piece piece, const BoardPos_t & pos);
-        std::size_t findOrMakeFreeQuadIndex();
+        util::SlotHandle
+            placeHead(Context & context, const std::size_t index, const bool isPlayer);
+
+        // at a random free position, returns false if there was none
+        bool spawnRivalSnake(Context & context);
+
+        // removes the head and the whole tail, O(tail length)
+        void killSnake(Context & context, const util::SlotHandle & head);
+
+        // Every head picks its next position, then any heads moving into the same cell all die,
+        // then every other head moves in turn.  Only touches the heads, so the cost is linear
+        // with the count of snakes and does not depend on how big the board is.
+        void takeTurns(Context & context);
+
+        // returns the count erased, checks the back first because that is where tails shrink
+        std::size_t eraseTailPiece(const util::SlotHandle & owner, const BoardPos_t & pos);
 
         std::string entryInvalidDesc(const PosEntry & entry) const;
 
-        void setupQuad(
-            Context & context,
-            const std::size_t quadIndex,
-            const BoardPos_t & pos,
-            const sf::Color & color = m_freeVertColor);
+        // returns m_grid.size() if pos is not on the board
+        std::size_t cellIndex(const BoardPos_t & pos) const;
+        BoardPos_t cellPosition(const std::size_t index) const;
 
-        void freeQuad(const std::size_t quadIndex);
-        void colorQuad(const std::size_t quadIndex, const sf::Color & color);
-        bool isQuadIndexValid(const std::size_t index) const;
-        bool isQuadFree(const std::size_t index) const;
+        // the only way m_grid should be changed, because it keeps m_freeCells, m_pieceBits,
+        // and the observer in sync
+        void setCellEntry(Context &, const std::size_t index, const PosEntryOpt_t & entryOpt);
+
+        // all of setCellEntry() but telling the observer, for when it gets told something else
+        void writeCellEntry(const std::size_t index, const PosEntryOpt_t & entryOpt);
+
+        // grows every set bit into its eight neighbors without wrapping across the board edges
+        util::BitBoard dilate(const util::BitBoard & bits) const;
 
       private:
-        static inline const sf::Color m_freeVertColor{ sf::Color::Transparent };
-        static inline const sf::Vertex m_freeQuadVertex{ { 0.0f, 0.0f }, m_freeVertColor };
-
-        std::map<BoardPos_t, PosEntry> m_posEntryMap;
-        std::vector<sf::Vertex> m_pieceVerts;
-
-        std::vector<HeadPiece> m_headPieces;
-        std::list<TailPiece> m_tailPieces;
-        std::vector<WallPiece> m_wallPieces;
-        std::vector<FoodPiece> m_foodPieces;
-        std::vector<ShrinkPiece> m_shrinkPieces;
-        std::vector<SlowPiece> m_slowPieces;
-
-        // clang-format off
-        static inline std::array<sf::Vector2i, 9> surroundingsPositionOffsets = {
-            sf::Vector2i{ -1, -1 },  sf::Vector2i{ 0, -1 },  sf::Vector2i{ 1, -1 },
-            sf::Vector2i{ -1,  0 },  sf::Vector2i{ 0,  0 },  sf::Vector2i{ 1,  0  },
-            sf::Vector2i{ -1,  1 },  sf::Vector2i{ 0,  1 },  sf::Vector2i{ 1,  1  },
+        // row-major (y * cell_counts.x + x) with one entry per cell, see cellIndex()
+        PosEntryGrid_t m_grid;
+        sf::Vector2i m_cellCounts{ 0, 0 };
+
+        // copy-on-write like the pieces below so that snapshot() can share it too
+        FreeCells m_freeCells;
+
+        std::array<util::BitBoard, piece::count> m_pieceBits;
+
+        // dilate() masks with these so bits shifted sideways can't jump to another row
+        util::BitBoard m_notFirstColumnBits;
+        util::BitBoard m_notLastColumnBits;
+
+        // Pieces are stored as parallel arrays instead of as objects:  the Piece is in m_grid and
+        // m_pieceBits, and the position is the cell index.  Only heads take turns so only they
+        // are objects, and each tail keeps its order from head to end in m_tailPositions,
+        // indexed by the SlotHandle::index of its head.  All of them are copy-on-write so that
+        // snapshot() can share them.
+        util::CowPtr<HeadPieces_t> m_headPieces;
+        std::vector<TailPositions_t> m_tailPositions;
+        util::SlotHandle m_playerHandle;
+
+        // re-used by tick() and takeTurns() so that taking turns never allocates
+        struct PlannedMove
+        {
+            util::SlotHandle head_handle;
+            BoardPos_t to_pos;
+            std::size_t to_index;
+            bool is_head_on;
         };
-        // clang-format on
+
+        std::vector<util::SlotHandle> m_headsTakingTurns;
+        std::vector<PlannedMove> m_plannedMoves;
+
+        mutable BoardPosVec_t m_foodPositions;
+        mutable bool m_isFoodPositionsStale{ true };
+
+        std::size_t m_ticksSinceValidate{ 0 };
     };
 } // namespace snake
 
@@ -7,10 +7,10 @@
 
 #include "check-macros.hpp"
 #include "context.hpp"
-#include "layout.hpp"
+#include "graphics-util.hpp"
 #include "media.hpp"
+#include "pixel-layout.hpp"
 #include "settings.hpp"
-#include "util.hpp"
 
 //
 
@@ -20,10 +20,10 @@ namespace snake
         : m_cellSizeTexture()
         , m_growFadeSprites()
         , m_growFadeTexts()
+        , m_isEnabled(true)
     {
         m_growFadeSprites.reserve(20);
         m_growFadeTexts.reserve(20);
-        setupCellTexture();
     }
 
     void Animations::reset()
@@ -32,7 +32,17 @@ namespace snake
         m_growFadeTexts.clear();
     }
 
-    void Animations::update(Context &, const float)
+    void Animations::isEnabled(const bool willEnable)
+    {
+        m_isEnabled = willEnable;
+
+        if (!m_isEnabled)
+        {
+            reset();
+        }
+    }
+
+    void Animations::update(FrontEndContext &, const float)
     {
         for (sf::Sprite & sprite : m_growFadeSprites)
         {
@@ -66,6 +76,16 @@ namespace snake
 
     void Animations::addGrowFadeAnim(const sf::FloatRect & rect, const sf::Color & color)
     {
+        if (!m_isEnabled)
+        {
+            return;
+        }
+
+        if (m_cellSizeTexture.getSize().x == 0)
+        {
+            setupCellTexture();
+        }
+
         sf::Sprite sprite(m_cellSizeTexture);
         sprite.setColor(color);
         util::fitAndCenterInside(sprite, rect);
@@ -73,15 +93,23 @@ namespace snake
     }
 
     void Animations::addRisingText(
-        const Context & context,
+        const FrontEndContext & context,
         const std::string & message,
         const sf::Color & color,
         const sf::FloatRect & cellBounds)
     {
-        const float heightLimit{ context.layout.window_size_f.y / 20.0f };
+        if (!m_isEnabled)
+        {
+            return;
+        }
+
+        const float heightLimit{ context.pixel_layout.window_size_f.y / 20.0f };
 
         const sf::FloatRect region(
-            0.0f, (cellBounds.top - heightLimit), context.layout.window_size_f.x, heightLimit);
+            0.0f,
+            (cellBounds.top - heightLimit),
+            context.pixel_layout.window_size_f.x,
+            heightLimit);
 
         sf::Text text(message, context.media.font(), 99);
         text.setFillColor(color);
@@ -11,7 +11,7 @@
 
 namespace snake
 {
-    struct Context;
+    struct FrontEndContext;
 
     //
 
@@ -28,12 +28,18 @@ namespace snake
         Animations & operator=(Animations &&) = delete;
 
         void reset();
-        void update(Context & context, const float elapsedTimeSec);
+
+        // when disabled nothing is added so there is nothing to update or draw, and the texture
+        // is only made the first time it is needed, so none of this needs an OpenGL context
+        void isEnabled(const bool willEnable);
+        bool isEnabled() const { return m_isEnabled; }
+
+        void update(FrontEndContext & context, const float elapsedTimeSec);
         void draw(sf::RenderTarget & target, sf::RenderStates states) const override; //-V813
         void addGrowFadeAnim(const sf::FloatRect & rect, const sf::Color & color);
 
         void addRisingText(
-            const Context & context,
+            const FrontEndContext & context,
             const std::string & message,
             const sf::Color & color,
             const sf::FloatRect & cellBounds);
@@ -47,6 +53,7 @@ namespace snake
         sf::Texture m_cellSizeTexture;
         std::vector<sf::Sprite> m_growFadeSprites;
         std::vector<sf::Text> m_growFadeTexts;
+        bool m_isEnabled;
     };
 } // namespace snake
 
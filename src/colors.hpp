@@ -0,0 +1,49 @@
+#ifndef SNAKE_COLORS_HPP_INCLUDED
+#define SNAKE_COLORS_HPP_INCLUDED
+//
+// colors.hpp
+//
+#include "pieces.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+// Only the front-end knows what anything looks like, the game rules never see a color.
+
+namespace snake
+{
+    namespace color
+    {
+        inline const sf::Color window_background{ sf::Color::Black };
+        inline const sf::Color alt_board_background{ 27, 0, 13 };
+        inline const sf::Color grow_fade_text{ 255, 255, 200 };
+    } // namespace color
+
+    namespace piece
+    {
+        inline const sf::Color tail_color_light{ 64, 255, 0 };
+
+        inline const sf::Color tail_color_dark{ static_cast<sf::Uint8>(tail_color_light.r / 4),
+                                                static_cast<sf::Uint8>(tail_color_light.g / 4),
+                                                static_cast<sf::Uint8>(tail_color_light.b / 4) };
+
+        // the rival snakes, see HeadPiece
+        inline const sf::Color rival_head_color{ 255, 140, 0 };
+        inline const sf::Color rival_tail_color{ 150, 70, 0 };
+
+        inline sf::Color toColor(const Piece piece)
+        {
+            switch (piece)
+            {
+                case Piece::Head: return sf::Color::Green;
+                case Piece::Tail: return tail_color_light;
+                case Piece::Food: return sf::Color::Yellow;
+                case Piece::Wall: return sf::Color(105, 70, 35);
+                case Piece::Slow: return sf::Color::Cyan;
+                case Piece::Shrink: return sf::Color::Magenta;
+                default: return sf::Color::Transparent;
+            }
+        }
+    } // namespace piece
+} // namespace snake
+
+#endif // SNAKE_COLORS_HPP_INCLUDED
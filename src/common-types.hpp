@@ -8,8 +8,7 @@
 #include <stdexcept>
 #include <vector>
 
-#include <SFML/Graphics/Rect.hpp>
-#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
 #include <SFML/Window/Keyboard.hpp>
 
 //
@@ -26,19 +25,13 @@ namespace snake
 
     // custom types
     using BoardPos_t = sf::Vector2i;
-    using BoardRect_t = sf::IntRect;
     using BoardPosVec_t = std::vector<BoardPos_t>;
     using BoardPosOpt_t = std::optional<BoardPos_t>;
-    using VertVec_t = std::vector<sf::Vertex>;
     using DirKeyOpt_t = std::optional<sf::Keyboard::Key>;
 
     // these ints are the number of columns in each row from top to bottom
     using ColCountPerRowVec_t = std::vector<int>;
 
-    using IntRectOpt_t = std::optional<sf::IntRect>;
-    using IntRectVec_t = std::vector<sf::IntRect>;
-    using IntRectVecVec_t = std::vector<IntRectVec_t>;
-
     // values
 
     const BoardPos_t BoardPosInvalid{ std::numeric_limits<int>::lowest(),
@@ -3,6 +3,7 @@
 //
 // context.hpp
 //
+#include <cstddef>
 
 namespace util
 {
@@ -14,44 +15,39 @@ namespace util
 namespace snake
 {
     class Board;
+    class BoardView;
     class Media;
     class GameConfig;
     class GameInPlay;
     class Animations;
+    struct IGameObserver;
     struct IStatesPending;
     class Layout;
+    class PixelLayout;
     struct IRegion;
     class ScoreFile;
 
     //
 
+    // Everything the game rules need, which is everything in the snake-core library.  Nothing
+    // here can draw or make a sound, the rules only tell the observer what happened.
     struct Context
     {
         Context(
             const GameConfig & con,
             const Layout & lay,
             GameInPlay & gam,
-            const Media & med,
             Board & bor,
             util::Random & ran,
-            util::SoundPlayer & aud,
-            util::AnimationPlayer & ani,
-            Animations & cellAnims,
             IStatesPending & sta,
-            IRegion & stat,
-            ScoreFile & scoreFile)
+            IGameObserver & obs)
             : config(con)
             , layout(lay)
             , game(gam)
-            , media(med)
             , board(bor)
             , random(ran)
-            , audio(aud)
-            , anim(ani)
-            , cell_anims(cellAnims)
             , state(sta)
-            , status(stat)
-            , score_file(scoreFile)
+            , observer(obs)
         {}
 
         Context(const Context &) = delete;
@@ -63,17 +59,77 @@ namespace snake
         const GameConfig & config;
         const Layout & layout;
         GameInPlay & game;
-        const Media & media;
         Board & board;
         const util::Random & random;
+        IStatesPending & state;
+        IGameObserver & observer;
+
+        // ticks since the game started, kept by GameInPlay::tick()
+        std::size_t sim_tick_count{ 0 };
+
+        // the tick the event being handled happened during, set when it is polled, and how many
+        // keys were ignored because the queue was full or they reversed direction (dropped) or
+        // because they repeated the key before them (coalesced), see HeadPiece::handleEvent()
+        std::size_t input_tick{ 0 };
+        std::size_t input_dropped_count{ 0 };
+        std::size_t input_coalesced_count{ 0 };
+    };
+
+    //
+
+    // The rules plus everything the SFML front-end needs to draw and play sounds.  The front-end
+    // passes this anywhere a Context is needed, but nothing in snake-core ever sees the rest.
+    struct FrontEndContext : public Context
+    {
+        FrontEndContext(
+            const GameConfig & con,
+            const Layout & lay,
+            const PixelLayout & pixelLay,
+            GameInPlay & gam,
+            const Media & med,
+            Board & bor,
+            BoardView & borView,
+            util::Random & ran,
+            util::SoundPlayer & aud,
+            util::AnimationPlayer & ani,
+            Animations & cellAnims,
+            IStatesPending & sta,
+            IGameObserver & obs,
+            IRegion & stat,
+            ScoreFile & scoreFile)
+            : Context(con, lay, gam, bor, ran, sta, obs)
+            , pixel_layout(pixelLay)
+            , media(med)
+            , board_view(borView)
+            , audio(aud)
+            , anim(ani)
+            , cell_anims(cellAnims)
+            , status(stat)
+            , score_file(scoreFile)
+        {}
+
+        FrontEndContext(const FrontEndContext &) = delete;
+        FrontEndContext(FrontEndContext &&) = delete;
+
+        FrontEndContext & operator=(const FrontEndContext &) = delete;
+        FrontEndContext & operator=(FrontEndContext &&) = delete;
+
+        // where the cells of the layout land on the window
+        const PixelLayout & pixel_layout;
+        const Media & media;
+        BoardView & board_view;
         util::SoundPlayer & audio;
         util::AnimationPlayer & anim;
         Animations & cell_anims;
-        IStatesPending & state;
         IRegion & status;
         ScoreFile & score_file;
 
         std::size_t fps{ 0 };
+        std::size_t vertex_bytes_per_frame{ 0 };
+
+        // how far the frame being drawn is from the last tick to the next one (0-1), kept by
+        // GameCoordinator::simulate()
+        float sim_tick_ratio{ 0.0f };
     };
 } // namespace snake
 
@@ -0,0 +1,270 @@
+#ifndef COPY_ON_WRITE_HPP_INCLUDED
+#define COPY_ON_WRITE_HPP_INCLUDED
+//
+// copy-on-write.hpp
+//
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace util
+{
+    // Copies share the same T until one of them calls write(), which clones it first if it is
+    // still shared.  Relies on shared_ptr::use_count() so copies must stay on one thread.
+    template <typename T>
+    class CowPtr
+    {
+      public:
+        CowPtr()
+            : m_ptr(std::make_shared<T>())
+        {}
+
+        const T & operator*() const { return *m_ptr; }
+        const T * operator->() const { return m_ptr.get(); }
+
+        T & write()
+        {
+            if (m_ptr.use_count() > 1)
+            {
+                m_ptr = std::make_shared<T>(*m_ptr);
+            }
+
+            return *m_ptr;
+        }
+
+        bool isSharedWith(const CowPtr & other) const { return (m_ptr == other.m_ptr); }
+
+      private:
+        std::shared_ptr<T> m_ptr;
+    };
+
+    // A fixed size array split into chunks that copies share until one of them writes, so
+    // copying costs one pointer per chunk and writing clones at most one chunk.  Only const
+    // access is offered through operator[] so that reading can never unshare a chunk by
+    // accident, use modify() or set() to write.  Same single thread rule as CowPtr.
+    template <typename T, std::size_t ChunkSize_v = 64>
+    class CowChunkedVector
+    {
+      public:
+        static inline const std::size_t chunk_size{ ChunkSize_v };
+
+        CowChunkedVector() = default;
+
+        void assign(const std::size_t count, const T & value)
+        {
+            m_size = count;
+            m_chunks.clear();
+            m_chunks.reserve((count + ChunkSize_v - 1) / ChunkSize_v);
+
+            for (std::size_t i(0); i < count; i += ChunkSize_v)
+            {
+                m_chunks.push_back(std::make_shared<Chunk_t>(ChunkSize_v, value));
+            }
+        }
+
+        std::size_t size() const { return m_size; }
+        bool empty() const { return (0 == m_size); }
+        std::size_t chunkCount() const { return m_chunks.size(); }
+
+        const T & operator[](const std::size_t index) const
+        {
+            return (*m_chunks[index / ChunkSize_v])[index % ChunkSize_v];
+        }
+
+        T & modify(const std::size_t index)
+        {
+            std::shared_ptr<Chunk_t> & chunkPtr{ m_chunks[index / ChunkSize_v] };
+
+            if (chunkPtr.use_count() > 1)
+            {
+                chunkPtr = std::make_shared<Chunk_t>(*chunkPtr);
+            }
+
+            return (*chunkPtr)[index % ChunkSize_v];
+        }
+
+        void set(const std::size_t index, const T & value) { modify(index) = value; }
+
+        // true if neither has written to this chunk since one was copied from the other
+        bool isChunkSharedWith(const CowChunkedVector & other, const std::size_t chunkIndex) const
+        {
+            return (m_chunks[chunkIndex] == other.m_chunks[chunkIndex]);
+        }
+
+      private:
+        using Chunk_t = std::vector<T>;
+
+        std::vector<std::shared_ptr<Chunk_t>> m_chunks;
+        std::size_t m_size{ 0 };
+    };
+
+    // A double-ended queue like RingBuffer but kept in chunks that copies share the same way
+    // CowChunkedVector does, so copying costs one pointer per chunk and push_front()/pop_back()
+    // clone at most the one chunk they touch.  Grows by adding a chunk to the front and gives
+    // chunks back as the back shrinks, so a snake that only moves keeps the same few chunks.
+    // Only const access, and T has to be copyable because unused slots hold copies of a real
+    // value.  Same single thread rule as CowPtr.
+    template <typename T, std::size_t ChunkSize_v = 64>
+    class CowChunkedRing
+    {
+      public:
+        class ConstIterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            ConstIterator(const CowChunkedRing & ring, const std::size_t index)
+                : m_ring(&ring)
+                , m_index(index)
+            {}
+
+            reference operator*() const { return (*m_ring)[m_index]; }
+            pointer operator->() const { return &(*m_ring)[m_index]; }
+
+            ConstIterator & operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            ConstIterator operator++(int)
+            {
+                ConstIterator before(*this);
+                ++m_index;
+                return before;
+            }
+
+            bool operator==(const ConstIterator & other) const
+            {
+                return ((m_ring == other.m_ring) && (m_index == other.m_index));
+            }
+
+            bool operator!=(const ConstIterator & other) const { return !(*this == other); }
+
+          private:
+            const CowChunkedRing * m_ring;
+            std::size_t m_index;
+        };
+
+        using const_iterator = ConstIterator;
+
+        CowChunkedRing() = default;
+
+        bool empty() const { return (0 == m_size); }
+        std::size_t size() const { return m_size; }
+        std::size_t chunkCount() const { return m_chunks.size(); }
+
+        void clear()
+        {
+            m_chunks.clear();
+            m_first = 0;
+            m_size = 0;
+        }
+
+        const T & operator[](const std::size_t index) const
+        {
+            const std::size_t slot{ m_first + index };
+            return (*m_chunks[slot / ChunkSize_v])[slot % ChunkSize_v];
+        }
+
+        const T & front() const { return (*this)[0]; }
+        const T & back() const { return (*this)[m_size - 1]; }
+
+        const_iterator begin() const { return const_iterator(*this, 0); }
+        const_iterator end() const { return const_iterator(*this, m_size); }
+
+        void push_front(const T & value)
+        {
+            if (0 == m_first)
+            {
+                m_chunks.insert(
+                    std::begin(m_chunks), std::make_shared<Chunk_t>(ChunkSize_v, value));
+                m_first = ChunkSize_v;
+            }
+
+            --m_first;
+            ++m_size;
+            modify(0) = value;
+        }
+
+        void pop_back()
+        {
+            if (empty())
+            {
+                throw std::runtime_error("CowChunkedRing::pop_back() called when empty!");
+            }
+
+            --m_size;
+            releaseBackChunks();
+        }
+
+        // removes everything after the first newSize elements, does nothing if already smaller
+        void truncate(const std::size_t newSize)
+        {
+            if (newSize < m_size)
+            {
+                m_size = newSize;
+                releaseBackChunks();
+            }
+        }
+
+        // O(n) because everything behind the erased element has to shift forward
+        void erase(const std::size_t index)
+        {
+            if (index >= m_size)
+            {
+                return;
+            }
+
+            for (std::size_t i(index + 1); i < m_size; ++i)
+            {
+                modify(i - 1) = (*this)[i];
+            }
+
+            --m_size;
+            releaseBackChunks();
+        }
+
+      private:
+        using Chunk_t = std::vector<T>;
+
+        T & modify(const std::size_t index)
+        {
+            const std::size_t slot{ m_first + index };
+            std::shared_ptr<Chunk_t> & chunkPtr{ m_chunks[slot / ChunkSize_v] };
+
+            if (chunkPtr.use_count() > 1)
+            {
+                chunkPtr = std::make_shared<Chunk_t>(*chunkPtr);
+            }
+
+            return (*chunkPtr)[slot % ChunkSize_v];
+        }
+
+        void releaseBackChunks()
+        {
+            if (empty())
+            {
+                clear();
+                return;
+            }
+
+            const std::size_t usedChunkCount{ (m_first + m_size + ChunkSize_v - 1) / ChunkSize_v };
+            m_chunks.resize(usedChunkCount);
+        }
+
+      private:
+        std::vector<std::shared_ptr<Chunk_t>> m_chunks;
+        std::size_t m_first{ 0 }; // slot of the front counting from the start of the first chunk
+        std::size_t m_size{ 0 };
+    };
+} // namespace util
+
+#endif // COPY_ON_WRITE_HPP_INCLUDED
@@ -0,0 +1,220 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// difficulty-tuner.cpp
+//
+#include "difficulty-tuner.hpp"
+
+#include "check-macros.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace snake
+{
+    DifficultyParams DifficultyParams::fromConfig(const GameConfig & config)
+    {
+        DifficultyParams params;
+        params.eat_count_base = config.level_eat_count_base;
+        params.turn_shrink_per_eat_base = config.level_turn_shrink_per_eat_base;
+        params.turn_shrink_per_eat_per_level = config.level_turn_shrink_per_eat_per_level;
+        params.obstacle_count_limit = config.obstacle_count_limit;
+        return params;
+    }
+
+    void DifficultyParams::applyTo(GameConfig & config) const
+    {
+        config.level_eat_count_base = eat_count_base;
+        config.level_turn_shrink_per_eat_base = turn_shrink_per_eat_base;
+        config.level_turn_shrink_per_eat_per_level = turn_shrink_per_eat_per_level;
+        config.obstacle_count_limit = obstacle_count_limit;
+    }
+
+    std::string DifficultyParams::toString() const
+    {
+        std::ostringstream ss;
+
+        ss << "eat=" << eat_count_base << "+sqrt(level), shrink=" << turn_shrink_per_eat_base
+           << '-' << turn_shrink_per_eat_per_level << "*level, obstacles<=" << obstacle_count_limit;
+
+        return ss.str();
+    }
+
+    //
+
+    DifficultyTuner::DifficultyTuner(
+        const GameConfig & config,
+        const SurvivalCurve_t & target,
+        const std::size_t gamesPerPoint,
+        const std::size_t threadCount,
+        const Seed_t seed)
+        : m_config(config)
+        , m_target(target)
+        , m_gamesPerPoint(gamesPerPoint)
+        , m_threadCount(threadCount)
+        , m_seed(seed)
+        , m_random(seed)
+        , m_points()
+    {
+        M_CHECK_SS(!m_target.empty(), "DifficultyTuner needs a target survival curve.");
+        M_CHECK_SS((m_gamesPerPoint > 0), m_gamesPerPoint);
+    }
+
+    DifficultyPoint DifficultyTuner::tune(const std::size_t iterationCount)
+    {
+        m_points.clear();
+
+        DifficultyPoint best{ evaluate(DifficultyParams::fromConfig(m_config)) };
+        m_points.push_back(best);
+        printPoint("Start", best);
+
+        float stepRatio{ 1.0f };
+        std::size_t failCount{ 0 };
+
+        for (std::size_t iteration(0); iteration < iterationCount; ++iteration)
+        {
+            const DifficultyPoint point{ evaluate(makeNeighbor(best.params, stepRatio)) };
+            m_points.push_back(point);
+
+            if (point.error < best.error)
+            {
+                best = point;
+                failCount = 0;
+                printPoint(("Better #" + std::to_string(iteration + 1)), point);
+            }
+            else if (++failCount >= m_failCountBeforeShrink)
+            {
+                failCount = 0;
+                stepRatio *= m_stepShrinkRatio;
+            }
+        }
+
+        printPoint("Best", best);
+        return best;
+    }
+
+    DifficultyPoint DifficultyTuner::evaluate(const DifficultyParams & params) const
+    {
+        GameConfig config{ m_config };
+        params.applyTo(config);
+
+        BatchSimulator batch(config);
+        batch.run(m_gamesPerPoint, m_threadCount, m_seed);
+
+        DifficultyPoint point;
+        point.params = params;
+        point.survival.resize(m_target.size(), 0.0f);
+
+        for (const BatchGameResult & result : batch.results())
+        {
+            const std::size_t levelsReached{ (result.is_timed_out) ? m_target.size()
+                                                                   : result.level_reached };
+
+            for (std::size_t index(0); index < std::min(levelsReached, m_target.size()); ++index)
+            {
+                point.survival[index] += 1.0f;
+            }
+
+            point.score_avg += static_cast<float>(result.score);
+            point.level_avg += static_cast<float>(result.level_reached);
+        }
+
+        const float gameCount{ static_cast<float>(batch.results().size()) };
+
+        point.score_avg /= gameCount;
+        point.level_avg /= gameCount;
+
+        for (std::size_t index(0); index < m_target.size(); ++index)
+        {
+            point.survival[index] /= gameCount;
+
+            const float diff{ point.survival[index] - m_target[index] };
+            point.error += (diff * diff);
+        }
+
+        return point;
+    }
+
+    DifficultyParams
+        DifficultyTuner::makeNeighbor(const DifficultyParams & params, const float stepRatio) const
+    {
+        DifficultyParams neighbor{ params };
+
+        // every step changes at least one param, and the rest half the time
+        const std::size_t mustChangeIndex{ m_random.zeroTo(3_st) };
+        const auto willChange = [&](const std::size_t index) {
+            return ((index == mustChangeIndex) || m_random.boolean());
+        };
+
+        if (willChange(0))
+        {
+            const int step{ std::max(1, static_cast<int>(3.0f * stepRatio)) };
+            const int eatCount{ static_cast<int>(params.eat_count_base) +
+                                m_random.fromTo(-step, step) };
+
+            neighbor.eat_count_base = static_cast<std::size_t>(
+                std::clamp(eatCount, static_cast<int>(m_eatCountBaseMin), 50));
+        }
+
+        if (willChange(1))
+        {
+            const float step{ 0.03f * stepRatio };
+            neighbor.turn_shrink_per_eat_base = std::clamp(
+                (params.turn_shrink_per_eat_base + m_random.fromTo(-step, step)), 0.5f, 1.0f);
+        }
+
+        if (willChange(2))
+        {
+            const float step{ 0.002f * stepRatio };
+            neighbor.turn_shrink_per_eat_per_level = std::clamp(
+                (params.turn_shrink_per_eat_per_level + m_random.fromTo(-step, step)),
+                0.0f,
+                0.02f);
+        }
+
+        if (willChange(3))
+        {
+            const int step{ std::max(1, static_cast<int>(10.0f * stepRatio)) };
+            const int obstacleCount{ static_cast<int>(params.obstacle_count_limit) +
+                                     m_random.fromTo(-step, step) };
+
+            neighbor.obstacle_count_limit =
+                static_cast<std::size_t>(std::clamp(obstacleCount, 0, 200));
+        }
+
+        return neighbor;
+    }
+
+    SurvivalCurve_t DifficultyTuner::makeTargetCurve(
+        const std::size_t levelCount, const float survivalPerLevel)
+    {
+        SurvivalCurve_t curve;
+        curve.reserve(levelCount);
+
+        float survival{ 1.0f };
+        for (std::size_t level(0); level < levelCount; ++level)
+        {
+            curve.push_back(survival);
+            survival *= survivalPerLevel;
+        }
+
+        return curve;
+    }
+
+    void DifficultyTuner::printPoint(const std::string & prefix, const DifficultyPoint & point)
+    {
+        std::cout << prefix << ": " << point.params.toString() << ", error=" << point.error
+                  << ", level_avg=" << point.level_avg << ", score_avg=" << point.score_avg
+                  << "\n  survival:";
+
+        std::cout << std::fixed << std::setprecision(2);
+        for (const float survival : point.survival)
+        {
+            std::cout << ' ' << survival;
+        }
+
+        std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+} // namespace snake
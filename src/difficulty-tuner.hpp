@@ -0,0 +1,99 @@
+#ifndef SNAKE_DIFFICULTY_TUNER_HPP_INCLUDED
+#define SNAKE_DIFFICULTY_TUNER_HPP_INCLUDED
+//
+// difficulty-tuner.hpp
+//
+#include "batch-simulator.hpp"
+#include "random.hpp"
+#include "settings.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace snake
+{
+    // the GameConfig values that Level::setup() uses to make each level harder than the last
+    struct DifficultyParams
+    {
+        static DifficultyParams fromConfig(const GameConfig & config);
+        void applyTo(GameConfig & config) const;
+
+        std::string toString() const;
+
+        std::size_t eat_count_base{ 0 };
+        float turn_shrink_per_eat_base{ 0.0f };
+        float turn_shrink_per_eat_per_level{ 0.0f };
+        std::size_t obstacle_count_limit{ 0 };
+    };
+
+    // The fraction of games that made it to each level, where index zero is level one which
+    // every game starts on.  Games that time out count as having made it to every level after.
+    using SurvivalCurve_t = std::vector<float>;
+
+    // one set of DifficultyParams and how the AI did playing with them
+    struct DifficultyPoint
+    {
+        DifficultyParams params;
+        SurvivalCurve_t survival;
+
+        // sum of the squared differences from the target curve, lower is better
+        float error{ 0.0f };
+
+        float score_avg{ 0.0f };
+        float level_avg{ 0.0f };
+    };
+
+    //
+
+    // Searches for the DifficultyParams that make the AI survive each level about as often as
+    // a target curve says it should.  Every point is played as a whole BatchSimulator batch,
+    // and every batch uses the same seeds, so two points only differ by their params and not
+    // by the luck of the games played.  The search is a random walk that only moves to points
+    // with less error, and takes smaller steps whenever it keeps failing to find one.
+    class DifficultyTuner
+    {
+      public:
+        DifficultyTuner(
+            const GameConfig & config,
+            const SurvivalCurve_t & target,
+            const std::size_t gamesPerPoint,
+            const std::size_t threadCount,
+            const Seed_t seed);
+
+        // starts from the params in the GameConfig, returns the best point found
+        DifficultyPoint tune(const std::size_t iterationCount);
+
+        DifficultyPoint evaluate(const DifficultyParams & params) const;
+
+        // every point evaluated by tune() in order
+        const std::vector<DifficultyPoint> & points() const { return m_points; }
+
+        // survivalPerLevel of the games that start a level make it to the next
+        static SurvivalCurve_t
+            makeTargetCurve(const std::size_t levelCount, const float survivalPerLevel);
+
+        static void printPoint(const std::string & prefix, const DifficultyPoint & point);
+
+      private:
+        DifficultyParams makeNeighbor(const DifficultyParams & params, const float stepRatio) const;
+
+      private:
+        GameConfig m_config;
+        SurvivalCurve_t m_target;
+        std::size_t m_gamesPerPoint;
+        std::size_t m_threadCount;
+        Seed_t m_seed;
+        util::Random m_random;
+        std::vector<DifficultyPoint> m_points;
+
+        // after this many points in a row that were no better, steps are made smaller
+        static inline const std::size_t m_failCountBeforeShrink{ 4 };
+        static inline const float m_stepShrinkRatio{ 0.5f };
+
+        // levels that need fewer than this many eaten leave no room for extra food
+        static inline const std::size_t m_eatCountBaseMin{ 4 };
+    };
+} // namespace snake
+
+#endif // SNAKE_DIFFICULTY_TUNER_HPP_INCLUDED
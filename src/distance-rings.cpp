@@ -0,0 +1,155 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// distance-rings.cpp
+//
+#include "distance-rings.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace snake
+{
+    DistanceRingQuery::DistanceRingQuery(
+        const sf::Vector2i & cellCounts,
+        const BoardPos_t & center,
+        const int targetDistance,
+        const DistanceRule rule,
+        const bool willWrap)
+        : m_cellCounts(cellCounts)
+        , m_center(center)
+        , m_rule(rule)
+        , m_willWrap(willWrap)
+        , m_offsetMin(0, 0)
+        , m_offsetMax(0, 0)
+        , m_targetDistance(std::max(0, targetDistance))
+        , m_maxRing(0)
+        , m_ring(0)
+        , m_offsetX(0)
+        , m_offsetXEnd(-1)
+        , m_side(0)
+        , m_isFinished(true)
+    {
+        if ((cellCounts.x <= 0) || (cellCounts.y <= 0))
+        {
+            return;
+        }
+
+        if (m_willWrap)
+        {
+            // on a torus with an even count, the cell exactly half way is reached going right
+            m_offsetMin = { -((cellCounts.x - 1) / 2), -((cellCounts.y - 1) / 2) };
+            m_offsetMax = { (cellCounts.x / 2), (cellCounts.y / 2) };
+        }
+        else
+        {
+            m_offsetMin = { -center.x, -center.y };
+            m_offsetMax = { ((cellCounts.x - 1) - center.x), ((cellCounts.y - 1) - center.y) };
+        }
+
+        m_maxRing =
+            (std::max(-m_offsetMin.x, m_offsetMax.x) + std::max(-m_offsetMin.y, m_offsetMax.y));
+
+        if (!isRingInRange(m_targetDistance))
+        {
+            // only Inside can still find something, by starting from the farthest ring
+            if ((DistanceRule::Inside != m_rule) || (m_maxRing < 0))
+            {
+                return;
+            }
+
+            m_targetDistance = m_maxRing;
+        }
+
+        m_isFinished = false;
+        startRing(m_targetDistance);
+    }
+
+    BoardPosOpt_t DistanceRingQuery::next()
+    {
+        while (!m_isFinished)
+        {
+            if (m_offsetX > m_offsetXEnd)
+            {
+                if (!advanceToNextRing())
+                {
+                    m_isFinished = true;
+                    break;
+                }
+
+                continue;
+            }
+
+            const int offsetX{ m_offsetX };
+            const int remaining{ m_ring - std::abs(offsetX) };
+            const int offsetY{ (0 == m_side) ? -remaining : remaining };
+
+            // the center column of each ring only has one cell when remaining is zero
+            if ((1 == m_side) || (0 == remaining))
+            {
+                m_side = 0;
+                ++m_offsetX;
+            }
+            else
+            {
+                m_side = 1;
+            }
+
+            if ((offsetY >= m_offsetMin.y) && (offsetY <= m_offsetMax.y))
+            {
+                return toBoardPos(offsetX, offsetY);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    bool DistanceRingQuery::isRingInRange(const int ring) const
+    {
+        return ((ring >= 0) && (ring <= m_maxRing));
+    }
+
+    void DistanceRingQuery::startRing(const int ring)
+    {
+        m_ring = ring;
+        m_offsetX = std::max(-ring, m_offsetMin.x);
+        m_offsetXEnd = std::min(ring, m_offsetMax.x);
+        m_side = 0;
+    }
+
+    bool DistanceRingQuery::advanceToNextRing()
+    {
+        int nextRing{ m_ring };
+
+        // clang-format off
+        switch (m_rule)
+        {
+            case DistanceRule::Exact:   { return false; }
+            case DistanceRule::Inside:  { --nextRing; break; }
+            case DistanceRule::Outside: { ++nextRing; break; }
+            default:                    { return false; }
+        }
+        // clang-format on
+
+        if (!isRingInRange(nextRing))
+        {
+            return false;
+        }
+
+        startRing(nextRing);
+        return true;
+    }
+
+    BoardPos_t DistanceRingQuery::toBoardPos(const int offsetX, const int offsetY) const
+    {
+        BoardPos_t pos{ (m_center.x + offsetX), (m_center.y + offsetY) };
+
+        if (m_willWrap)
+        {
+            pos.x = (((pos.x % m_cellCounts.x) + m_cellCounts.x) % m_cellCounts.x);
+            pos.y = (((pos.y % m_cellCounts.y) + m_cellCounts.y) % m_cellCounts.y);
+        }
+
+        return pos;
+    }
+} // namespace snake
@@ -0,0 +1,77 @@
+#ifndef SNAKE_DISTANCE_RINGS_HPP_INCLUDED
+#define SNAKE_DISTANCE_RINGS_HPP_INCLUDED
+//
+// distance-rings.hpp
+//
+#include "common-types.hpp"
+
+#include <optional>
+
+#include <SFML/System/Vector2.hpp>
+
+//
+
+namespace snake
+{
+    enum class DistanceRule
+    {
+        Exact,
+        Inside,
+        Outside
+    };
+
+    // Walks the Manhattan distance rings around a center cell without ever looking at cells
+    // that can't match.  Rings are visited closest to targetDistance first (so Inside walks
+    // inward and Outside walks outward) and every on-board position is returned only once.
+    // When willWrap is true distance is measured on a torus the same way the snake travels
+    // through Layout::findWraparoundPos(), so the far edge counts as next to the near edge.
+    class DistanceRingQuery
+    {
+      public:
+        DistanceRingQuery(
+            const sf::Vector2i & cellCounts,
+            const BoardPos_t & center,
+            const int targetDistance,
+            const DistanceRule rule,
+            const bool willWrap = false);
+
+        // returns std::nullopt when there are no more positions
+        BoardPosOpt_t next();
+
+        // only valid after next() has returned a position
+        int currentDistance() const { return m_ring; }
+
+        // the distance of the farthest position on the board from the center
+        int maxDistance() const { return m_maxRing; }
+
+      private:
+        bool isRingInRange(const int ring) const;
+        void startRing(const int ring);
+        bool advanceToNextRing();
+        BoardPos_t toBoardPos(const int offsetX, const int offsetY) const;
+
+      private:
+        sf::Vector2i m_cellCounts;
+        BoardPos_t m_center;
+        DistanceRule m_rule;
+        bool m_willWrap;
+
+        // the range of offsets from m_center that land on the board, which when wrapping is
+        // the one offset per column/row with the smallest absolute value
+        sf::Vector2i m_offsetMin;
+        sf::Vector2i m_offsetMax;
+
+        int m_targetDistance;
+        int m_maxRing;
+
+        // where the walk is, each ring goes left to right by column and each column has up to
+        // two cells, one above and one below the center
+        int m_ring;
+        int m_offsetX;
+        int m_offsetXEnd;
+        int m_side;
+        bool m_isFinished;
+    };
+} // namespace snake
+
+#endif // SNAKE_DISTANCE_RINGS_HPP_INCLUDED
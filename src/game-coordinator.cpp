@@ -5,7 +5,9 @@
 //
 #include "game-coordinator.hpp"
 
-#include "util.hpp"
+#include "colors.hpp"
+#include "graphics-util.hpp"
+#include "keys.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -21,39 +23,108 @@ namespace snake
         : m_configOriginalCopy(configOrig)
         , m_config()
         , m_layout()
+        , m_pixelLayout()
         , m_media()
         , m_game()
         , m_window()
         , m_bloomWindow()
         , m_board()
+        , m_boardView()
         , m_random()
-        , m_soundPlayer(m_random)
-        , m_animationPlayer(m_random)
+        , m_presentationRandom()
+        , m_soundPlayer(m_presentationRandom)
+        , m_animationPlayer(m_presentationRandom)
         , m_cellAnims()
         , m_statusRegion()
+        , m_nullStatusRegion()
         , m_stateMachine()
         , m_scoreFile()
+        , m_nullObserver()
         , m_context(
               m_config,
               m_layout,
+              m_pixelLayout,
               m_game,
               m_media,
               m_board,
+              m_boardView,
               m_random,
               m_soundPlayer,
               m_animationPlayer,
               m_cellAnims,
               m_stateMachine,
-              m_statusRegion,
+              pickObserver(configOrig),
+              pickStatusRegion(configOrig),
               m_scoreFile)
+        , m_eatSfxPitch(1.0f)
         , m_runClock()
+        , m_simUnspentMicroSec(0)
+        , m_inputScript()
+        , m_headlessResults()
+        , m_seed(0)
+        , m_recordPathOpt()
+        , m_recording()
+        , m_replayOpt()
+        , m_replayIndex(0)
     {}
 
+    IRegion & GameCoordinator::pickStatusRegion(const GameConfig & config)
+    {
+        if (config.is_headless)
+        {
+            return m_nullStatusRegion;
+        }
+
+        return m_statusRegion;
+    }
+
+    IGameObserver & GameCoordinator::pickObserver(const GameConfig & config)
+    {
+        // nothing is drawn or heard when headless, so the Board doesn't need to say anything
+        if (config.is_headless)
+        {
+            return m_nullObserver;
+        }
+
+        return *this;
+    }
+
     void GameCoordinator::setup(const GameConfig & configParam)
     {
         // don't call m_config::reset() because that would erase all customizations in configParam
         m_config = configParam;
 
+        // the FrontEndContext was bound to a status region and observer when constructed
+        M_CHECK_SS(
+            (m_config.is_headless == m_configOriginalCopy.is_headless),
+            "is_headless can't change after the GameCoordinator is constructed");
+
+        M_CHECK_SS((m_config.sim_ticks_per_sec > 0), m_config.sim_ticks_per_sec);
+        M_CHECK_SS((m_config.sim_ticks_per_frame_max > 0), m_config.sim_ticks_per_frame_max);
+        M_CHECK_SS((m_config.sim_speed > 0.0f), m_config.sim_speed);
+
+        if (isReplaying())
+        {
+            m_replayOpt->applyConfigTo(m_config);
+            m_config.headless_tick_limit = replayTickLimit();
+            m_replayIndex = 0;
+        }
+
+        // a recording only ever holds one game
+        if (isReplaying() || isRecording())
+        {
+            m_config.headless_game_count = 1;
+        }
+
+        m_seed = m_config.random_seed.value_or(std::random_device{}());
+        m_random.reseed(m_seed);
+
+        if (m_config.is_headless)
+        {
+            setupHeadless();
+            return;
+        }
+
         M_CHECK_SS(std::filesystem::exists(m_config.media_path), m_config.media_path);
         M_CHECK_SS(std::filesystem::is_directory(m_config.media_path), m_config.media_path);
         m_config.media_path = std::filesystem::canonical(m_config.media_path);
@@ -64,8 +135,12 @@ namespace snake
         m_window.setMouseCursorVisible(false);
 
         m_layout.reset(m_config);
+        m_pixelLayout.reset(m_config, m_layout);
         m_media.reset(m_config.media_path);
-        m_board.reset();
+        m_board.reset(m_layout);
+        m_boardView.reset(m_layout);
+        m_boardView.loadShaders();
+        m_cellAnims.isEnabled(true);
         m_cellAnims.reset();
         m_animationPlayer.reset((m_config.media_path / "animation").string());
         m_soundPlayer.reset((m_config.media_path / "sfx").string());
@@ -91,13 +166,41 @@ namespace snake
         m_stateMachine.setChangePending(State::Option);
     }
 
+    void GameCoordinator::setupHeadless()
+    {
+        // Nothing is loaded and nothing touches OpenGL or the audio device:  the status region
+        // is a NullRegion, the sound player is silent with nothing loaded so play() returns
+        // right away, and the cell animations are disabled.  The AnimationPlayer is only ever
+        // drawn and Media only ever used to draw, so both are left empty.
+        if ((0 == m_config.resolution.x) || (0 == m_config.resolution.y))
+        {
+            m_config.resolution = m_headlessResolution;
+        }
+
+        m_layout.reset(m_config);
+        m_pixelLayout.reset(m_config, m_layout);
+        m_board.reset(m_layout);
+        m_cellAnims.isEnabled(false);
+        m_soundPlayer.volume(0.0f);
+
+        m_stateMachine.reset();
+        m_stateMachine.setChangePending(State::Option);
+    }
+
     const sf::VideoMode GameCoordinator::pickResolution() const
     {
+        const unsigned int desktopBitsPerPixel{ sf::VideoMode::getDesktopMode().bitsPerPixel };
+
+        // the Layout depends on the resolution, so a replay has to use the one it was played on
+        if (isReplaying())
+        {
+            return sf::VideoMode(
+                m_config.resolution.x, m_config.resolution.y, desktopBitsPerPixel);
+        }
+
         std::vector<sf::VideoMode> videoModes = sf::VideoMode::getFullscreenModes();
 
         // remove all with different bit depths
-        const unsigned int desktopBitsPerPixel{ sf::VideoMode::getDesktopMode().bitsPerPixel };
-
         videoModes.erase(
             std::remove_if(
                 std::begin(videoModes),
@@ -132,11 +235,28 @@ namespace snake
         const sf::VideoMode videoMode = pickResolution();
         std::cout << "Video Mode Selected: " << videoMode << '\n';
 
-        m_window.create(videoMode, "Snake", m_config.sf_window_style);
+        // a replay's resolution might not be one the screen can go fullscreen with
+        const unsigned int windowStyle{ (isReplaying())
+                                            ? static_cast<unsigned>(sf::Style::Close)
+                                            : m_config.sf_window_style };
+
+        m_window.create(videoMode, "Snake", windowStyle);
         M_CHECK_SS(m_window.isOpen(), "Failed to open a window with these settings: " << videoMode);
 
-        m_config.resolution.x = m_window.getSize().x;
-        m_config.resolution.y = m_window.getSize().y;
+        if (isReplaying())
+        {
+            // if the window came out smaller, the whole recorded board is scaled down to fit
+            m_window.setView(sf::View(sf::FloatRect(
+                0.0f,
+                0.0f,
+                static_cast<float>(m_config.resolution.x),
+                static_cast<float>(m_config.resolution.y))));
+        }
+        else
+        {
+            m_config.resolution.x = m_window.getSize().x;
+            m_config.resolution.y = m_window.getSize().y;
+        }
 
         m_window.setFramerateLimit(m_config.frame_rate_limit);
 
@@ -152,7 +272,26 @@ namespace snake
     void GameCoordinator::play(const GameConfig & config)
     {
         setup(config);
+
+        if (isRecording())
+        {
+            m_recording = Recording();
+            m_recording.seed = m_seed;
+            m_recording.captureConfig(m_config);
+        }
+
+        if (m_config.is_headless)
+        {
+            headlessLoop();
+            printHeadlessSummary();
+            saveRecording();
+            printReplayResult();
+            return;
+        }
+
         frameLoop();
+        saveRecording();
+        printReplayResult();
 
         if (m_config.isTest())
         {
@@ -164,6 +303,8 @@ namespace snake
 
         std::cout << "Play Time: " << runTimeSec << "sec\n";
         std::cout << "Final Score: " << m_game.score() << '\n';
+        std::cout << "Keys Dropped: " << m_context.input_dropped_count << '\n';
+        std::cout << "Keys Coalesced: " << m_context.input_coalesced_count << '\n';
         std::cout << "High Score : " << m_scoreFile.readHighScore() << std::endl;
     }
 
@@ -173,18 +314,252 @@ namespace snake
         sf::Clock periodClock;
         std::size_t frameCounter{ 0 };
 
+        m_simUnspentMicroSec = 0;
+        m_context.sim_tick_count = 0;
+        m_context.sim_tick_ratio = 0.0f;
+
         m_runClock.restart();
 
+        // the game only changes in simulate(), update() is for animations that only look
         while (willContinue())
         {
             handlePeriodicTasks(periodClock, frameCounter);
-            handleEvents();
-            update(frameClock.restart().asSeconds());
+            handleEvents(frameClock);
+            const sf::Time frameTime{ frameClock.restart() };
+            simulate(frameTime.asMicroseconds());
+            update(frameTime.asSeconds());
             draw();
             m_stateMachine.changeIfPending(m_context);
         }
     }
 
+    void GameCoordinator::headlessLoop()
+    {
+        // there is no frame time, so each pass is exactly one tick
+        const float secPerTick{ 1.0f / static_cast<float>(m_config.sim_ticks_per_sec) };
+
+        std::size_t scriptIndex{ 0 };
+        std::size_t gameStartTick{ 0 };
+        bool isTimedOut{ false };
+
+        m_context.sim_tick_count = 0;
+        m_context.sim_tick_ratio = 1.0f;
+        m_headlessResults.clear();
+        m_runClock.restart();
+
+        while (true)
+        {
+            m_stateMachine.changeIfPending(m_context);
+
+            if (m_stateMachine.stateEnum() == State::Quit)
+            {
+                m_headlessResults.push_back({ m_game.score(),
+                                              m_game.level().number,
+                                              (m_context.sim_tick_count - gameStartTick),
+                                              isTimedOut });
+
+                if (m_headlessResults.size() >= m_config.headless_game_count)
+                {
+                    break;
+                }
+
+                scriptIndex = 0;
+                gameStartTick = m_context.sim_tick_count;
+                isTimedOut = false;
+
+                // the same as the player choosing to play again
+                m_stateMachine.reset();
+                m_stateMachine.setChangePending(State::Option);
+                continue;
+            }
+
+            handleHeadlessInput(gameStartTick, scriptIndex);
+
+            if (!m_stateMachine.isChangePending())
+            {
+                m_stateMachine.state().tick(m_context);
+            }
+
+            m_stateMachine.state().update(m_context, secPerTick);
+
+            if (!isTimedOut &&
+                ((m_context.sim_tick_count - gameStartTick) >= m_config.headless_tick_limit))
+            {
+                isTimedOut = true;
+                m_stateMachine.setChangePending(State::Quit);
+            }
+        }
+    }
+
+    void GameCoordinator::handleHeadlessInput(
+        const std::size_t gameStartTick, std::size_t & scriptIndex)
+    {
+        sf::Event event;
+        event.type = sf::Event::KeyPressed;
+        event.key = { sf::Keyboard::Unknown, false, false, false, false };
+
+        if (isReplaying())
+        {
+            handleReplayInput();
+        }
+        else
+        {
+            // every game starts the script over, with its ticks counted from the start of the
+            // game
+            while ((scriptIndex < m_inputScript.size()) &&
+                   ((gameStartTick + m_inputScript[scriptIndex].tick) <=
+                    m_context.sim_tick_count))
+            {
+                event.key.code = m_inputScript[scriptIndex].key;
+                m_context.input_tick = m_context.sim_tick_count;
+                passEventToState(event);
+                ++scriptIndex;
+            }
+        }
+
+        // nobody is there to press a key to get past the messages between levels
+        if ((m_stateMachine.stateEnum() != State::Play) && !m_stateMachine.isChangePending())
+        {
+            event.key.code = sf::Keyboard::Enter;
+            m_stateMachine.state().handleEvent(m_context, event);
+        }
+    }
+
+    void GameCoordinator::passEventToState(const sf::Event & event)
+    {
+        // Only keys that can change the game are kept, and only the ones that reach it, since
+        // every other key does nothing to the board and no tick runs outside of State::Play.
+        const bool willRecord{ isRecording() && (sf::Event::KeyPressed == event.type) &&
+                               (m_stateMachine.stateEnum() == State::Play) &&
+                               !m_stateMachine.isChangePending() &&
+                               (keys::isArrow(event.key.code) ||
+                                (sf::Keyboard::Q == event.key.code)) };
+
+        if (willRecord)
+        {
+            m_recording.inputs.push_back(
+                { m_context.sim_tick_count, m_context.input_tick, event.key.code });
+        }
+
+        m_stateMachine.state().handleEvent(m_context, event);
+    }
+
+    void GameCoordinator::handleReplayInput()
+    {
+        const std::vector<RecordedInput> & inputs{ m_replayOpt->inputs };
+
+        sf::Event event;
+        event.type = sf::Event::KeyPressed;
+        event.key = { sf::Keyboard::Unknown, false, false, false, false };
+
+        // keys were only recorded while playing, and any key that changed the state stopped
+        // the rest polled with it from reaching the game, so the same has to happen here
+        while ((m_replayIndex < inputs.size()) &&
+               (inputs[m_replayIndex].poll_tick <= m_context.sim_tick_count) &&
+               (m_stateMachine.stateEnum() == State::Play) && !m_stateMachine.isChangePending())
+        {
+            const RecordedInput & input{ inputs[m_replayIndex++] };
+            event.key.code = input.key;
+            m_context.input_tick = input.input_tick;
+            passEventToState(event);
+        }
+    }
+
+    std::size_t GameCoordinator::replayTickLimit() const
+    {
+        // a game that ended by itself gets one more tick than it took, so that running out of
+        // ticks can't be what ends it
+        return (m_replayOpt->final_tick_count + ((m_replayOpt->is_game_over) ? 1 : 0));
+    }
+
+    void GameCoordinator::saveRecording()
+    {
+        if (!isRecording())
+        {
+            return;
+        }
+
+        m_recording.final_score = m_game.score();
+        m_recording.final_level = m_game.level().number;
+        m_recording.final_tick_count = m_context.sim_tick_count;
+        m_recording.is_game_over = m_game.isGameOver();
+        m_recording.save(m_recordPathOpt.value());
+
+        std::cout << "Recorded " << m_recording.inputs.size() << " keys over "
+                  << m_recording.final_tick_count << " ticks with seed " << m_recording.seed
+                  << " to " << m_recordPathOpt.value() << std::endl;
+    }
+
+    void GameCoordinator::printReplayResult() const
+    {
+        if (!isReplaying())
+        {
+            return;
+        }
+
+        const Recording & recording{ m_replayOpt.value() };
+
+        const bool isMatch{ (m_game.score() == recording.final_score) &&
+                            (m_game.level().number == recording.final_level) &&
+                            (m_context.sim_tick_count == recording.final_tick_count) &&
+                            (m_game.isGameOver() == recording.is_game_over) };
+
+        if (isMatch)
+        {
+            std::cout << "Replay Matched: score=" << recording.final_score
+                      << ", level=" << recording.final_level
+                      << ", ticks=" << recording.final_tick_count << std::endl;
+
+            return;
+        }
+
+        std::cout << "Replay DID NOT Match:";
+        std::cout << "\n  score     = " << m_game.score() << " but was " << recording.final_score;
+        std::cout << "\n  level     = " << m_game.level().number << " but was "
+                  << recording.final_level;
+
+        std::cout << "\n  ticks     = " << m_context.sim_tick_count << " but was "
+                  << recording.final_tick_count;
+
+        std::cout << "\n  game over = " << std::boolalpha << m_game.isGameOver() << " but was "
+                  << recording.is_game_over << std::noboolalpha << std::endl;
+    }
+
+    void GameCoordinator::printHeadlessSummary() const
+    {
+        const double runTimeSec{ std::max(
+            0.001, static_cast<double>(m_runClock.getElapsedTime().asSeconds())) };
+
+        std::size_t timedOutCount{ 0 };
+        std::size_t tickCount{ 0 };
+        std::size_t levelSum{ 0 };
+        long long scoreSum{ 0 };
+        int scoreMax{ 0 };
+        for (const HeadlessGameResult & result : m_headlessResults)
+        {
+            timedOutCount += ((result.is_timed_out) ? 1 : 0);
+            tickCount += result.tick_count;
+            levelSum += result.level_reached;
+            scoreSum += result.score;
+            scoreMax = std::max(scoreMax, result.score);
+        }
+
+        const double gameCount{ static_cast<double>(std::max(1_st, m_headlessResults.size())) };
+
+        std::cout << "Headless Games: " << m_headlessResults.size() << " (" << timedOutCount
+                  << " timed out)\n";
+
+        std::cout << "Score Avg/Max: " << (static_cast<double>(scoreSum) / gameCount) << '/'
+                  << scoreMax << '\n';
+
+        std::cout << "Level Avg: " << (static_cast<double>(levelSum) / gameCount) << '\n';
+        std::cout << "Run Time: " << runTimeSec << "sec\n";
+        std::cout << "Games/Min: " << ((gameCount * 60.0) / runTimeSec) << '\n';
+
+        std::cout << "Ticks/Sec: " << (static_cast<double>(tickCount) / runTimeSec)
+                  << std::endl;
+    }
+
     void GameCoordinator::handlePeriodicTasks(sf::Clock & periodClock, std::size_t & frameCounter)
     {
         ++frameCounter;
@@ -197,46 +572,95 @@ namespace snake
 
         const float fps{ static_cast<float>(frameCounter) / elapsedSec };
 
+        m_context.fps = static_cast<std::size_t>(std::roundf(fps));
+        m_context.vertex_bytes_per_frame = (m_boardView.uploadedVertexBytes() / frameCounter);
+        m_boardView.resetUploadedVertexBytes();
+
         frameCounter = 0;
         periodClock.restart();
-
-        m_context.fps = static_cast<std::size_t>(std::roundf(fps));
         m_statusRegion.updateText(m_context);
 
         m_cellAnims.cleanup();
+    }
+
+    void GameCoordinator::simulate(const sf::Int64 elapsedMicroSec)
+    {
+        const sf::Int64 microSecPerTick{ this->microSecPerTick() };
+
+        // faster replays need more ticks per frame to keep up
+        const sf::Int64 speedTicksMax{ static_cast<sf::Int64>(
+            std::ceil(std::max(1.0f, m_config.sim_speed))) };
 
-        // Periodically place new food at random place on the map, because there
-        // are just too many ways for food to either be destroyed or unreachable.
-        // Also take this opportunity to place rare helper pieces like slow/shrink.
-        if ((m_stateMachine.stateEnum() == State::Play) && !m_game.isGameOver() &&
-            !m_game.level().isComplete())
+        const sf::Int64 unspentMicroSecMax{
+            microSecPerTick *
+            (static_cast<sf::Int64>(m_config.sim_ticks_per_frame_max) * speedTicksMax)
+        };
+
+        m_simUnspentMicroSec =
+            std::min((m_simUnspentMicroSec + elapsedMicroSec), unspentMicroSecMax);
+
+        // stop at a state change so the rest of the ticks don't play after the level has ended
+        while ((m_simUnspentMicroSec >= microSecPerTick) && !m_stateMachine.isChangePending())
         {
-            if ((m_game.level().remainingToEat() > 0) && (m_board.countPieces(Piece::Food) == 0))
+            // recorded keys go in between ticks, exactly where they did when first played
+            if (isReplaying() && (m_stateMachine.stateEnum() == State::Play))
             {
-                m_board.addNewPieceAtRandomFreePos(m_context, Piece::Food);
+                handleReplayInput();
+
+                if (m_stateMachine.isChangePending())
+                {
+                    break;
+                }
 
-                if (m_game.level().remainingToEat() <= 4)
+                if (m_context.sim_tick_count >= replayTickLimit())
                 {
-                    if (m_random.boolean() && (m_board.countPieces(Piece::Slow) == 0))
-                    {
-                        m_board.addNewPieceAtRandomFreePos(m_context, Piece::Slow);
-                    }
-
-                    if (m_random.boolean() && (m_board.countPieces(Piece::Shrink) == 0))
-                    {
-                        m_board.addNewPieceAtRandomFreePos(m_context, Piece::Shrink);
-                    }
+                    m_stateMachine.setChangePending(State::Quit);
+                    break;
                 }
             }
+
+            m_simUnspentMicroSec -= microSecPerTick;
+            m_stateMachine.state().tick(m_context);
         }
+
+        m_context.sim_tick_ratio = std::clamp(
+            (static_cast<float>(m_simUnspentMicroSec) / static_cast<float>(microSecPerTick)),
+            0.0f,
+            1.0f);
     }
 
-    void GameCoordinator::handleEvents()
+    void GameCoordinator::handleEvents(const sf::Clock & frameClock)
     {
+        // The ticks for the time since the last frame have not run yet, so stamp each event
+        // with the tick it would have happened during if they had, which is the best that can
+        // be done without knowing exactly when the key went down.
+        const sf::Int64 unspentMicroSec{ m_simUnspentMicroSec +
+                                         frameClock.getElapsedTime().asMicroseconds() };
+
+        m_context.input_tick = (m_context.sim_tick_count +
+                                static_cast<std::size_t>(unspentMicroSec / microSecPerTick()));
+
         sf::Event event;
 
         while (willContinue() && m_window.pollEvent(event))
         {
+            // only the recording plays a replay, but it can still be closed or stopped early
+            if (isReplaying() && (sf::Event::Closed != event.type) &&
+                !((sf::Event::KeyPressed == event.type) &&
+                  (sf::Keyboard::Escape == event.key.code)))
+            {
+                continue;
+            }
+
+            passEventToState(event);
+        }
+
+        // nobody has to press a key to get past the messages between levels of a replay
+        if (isReplaying() && willContinue() && (m_stateMachine.stateEnum() != State::Play) &&
+            !m_stateMachine.isChangePending())
+        {
+            event.type = sf::Event::KeyPressed;
+            event.key = { sf::Keyboard::Enter, false, false, false, false };
             m_stateMachine.state().handleEvent(m_context, event);
         }
     }
@@ -248,7 +672,7 @@ namespace snake
 
     void GameCoordinator::draw()
     {
-        m_bloomWindow->clear(m_config.window_background_color);
+        m_bloomWindow->clear(color::window_background);
         m_stateMachine.state().draw(m_context, m_bloomWindow->renderTarget(), sf::RenderStates());
         m_bloomWindow->display();
     }
@@ -258,6 +682,98 @@ namespace snake
         std::cout << std::endl;
         std::cout << m_config.toString() << "\n\n";
         std::cout << m_layout.toString() << "\n\n";
+        std::cout << m_pixelLayout.toString() << "\n\n";
         std::cout << m_game.toString() << std::endl;
     }
+
+    void GameCoordinator::onBoardCleared() { m_boardView.onBoardCleared(m_context); }
+
+    void GameCoordinator::onCellChanged(
+        const std::size_t cellIndex,
+        const PieceEnumOpt_t & pieceBefore,
+        const PieceEnumOpt_t & pieceAfter,
+        const util::SlotHandle & owner)
+    {
+        m_boardView.onCellChanged(m_context, cellIndex, pieceBefore, pieceAfter, owner);
+    }
+
+    void GameCoordinator::onPieceMoved(
+        const std::size_t fromCellIndex, const std::size_t toCellIndex)
+    {
+        m_boardView.onPieceMoved(m_context, fromCellIndex, toCellIndex);
+    }
+
+    void GameCoordinator::onPlayerTailChanged() { m_boardView.onPlayerTailChanged(m_context); }
+
+    void GameCoordinator::onBoardRestored() { m_boardView.onBoardRestored(m_context); }
+
+    void GameCoordinator::onLevelStarted(const std::size_t)
+    {
+        m_eatSfxPitch = m_config.eat_sfx_pitch_start;
+
+        // loading the same map again frees every quad without clearing the BoardView
+        m_boardView.compactQuadsIfFragmented();
+    }
+
+    void GameCoordinator::onInputQueued(const sf::Keyboard::Key)
+    {
+        m_soundPlayer.play("tap-1-a.ogg");
+    }
+
+    void GameCoordinator::onFoodMissed(const BoardPos_t & foodPos)
+    {
+        m_soundPlayer.play("miss");
+
+        m_cellAnims.addRisingText(
+            m_context, "miss", color::grow_fade_text, m_pixelLayout.cellBounds(foodPos));
+    }
+
+    void GameCoordinator::onFoodEaten(
+        const BoardPos_t & pos, const int scoreEarned, const bool isLifeBonus)
+    {
+        m_soundPlayer.play("shine", m_eatSfxPitch);
+        m_eatSfxPitch += m_config.eat_sfx_pitch_adj;
+
+        m_cellAnims.addGrowFadeAnim(m_pixelLayout.cellBounds(pos), piece::toColor(Piece::Food));
+
+        const std::string message{ (isLifeBonus) ? "LIFE BONUS!"
+                                                 : ("+" + std::to_string(scoreEarned)) };
+
+        m_cellAnims.addRisingText(
+            m_context, message, color::grow_fade_text, m_pixelLayout.cellBounds(pos));
+    }
+
+    void GameCoordinator::onSlowEaten(const BoardPos_t & pos)
+    {
+        m_soundPlayer.play("slow", m_eatSfxPitch);
+
+        m_cellAnims.addGrowFadeAnim(m_pixelLayout.cellBounds(pos), piece::toColor(Piece::Slow));
+
+        m_cellAnims.addRisingText(
+            m_context, "SLOW!", color::grow_fade_text, m_pixelLayout.cellBounds(pos));
+    }
+
+    void GameCoordinator::onShrinkEaten(const BoardPos_t & pos)
+    {
+        m_soundPlayer.play("explode-puff", m_eatSfxPitch);
+
+        m_cellAnims.addGrowFadeAnim(m_pixelLayout.cellBounds(pos), piece::toColor(Piece::Shrink));
+
+        m_cellAnims.addRisingText(
+            m_context, "SHRINK!", color::grow_fade_text, m_pixelLayout.cellBounds(pos));
+    }
+
+    void GameCoordinator::onLifeLost(const Piece pieceBitten)
+    {
+        if (pieceBitten == Piece::Wall)
+        {
+            m_soundPlayer.play("mario-break-block");
+        }
+        else if ((pieceBitten == Piece::Tail) || (pieceBitten == Piece::Head))
+        {
+            m_soundPlayer.play("step-smash-yuck");
+        }
+    }
+
+    void GameCoordinator::onGameStatusChanged() { m_context.status.updateText(m_context); }
 } // namespace snake
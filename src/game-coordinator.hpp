@@ -3,27 +3,47 @@
 
 #include "animation-player.hpp"
 #include "bloom-shader.hpp"
+#include "board-view.hpp"
 #include "board.hpp"
 #include "cell-animations.hpp"
 #include "context.hpp"
+#include "game-observer.hpp"
 #include "layout.hpp"
 #include "media.hpp"
 #include "pieces.hpp"
+#include "pixel-layout.hpp"
 #include "random.hpp"
+#include "recording.hpp"
 #include "score-file.hpp"
 #include "settings.hpp"
 #include "sound-player.hpp"
 #include "states.hpp"
 #include "status-region.hpp"
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
 namespace snake
 {
-    class GameCoordinator
+    // one game played with GameConfig::is_headless
+    struct HeadlessGameResult
+    {
+        int score{ 0 };
+        std::size_t level_reached{ 0 };
+        std::size_t tick_count{ 0 };
+        bool is_timed_out{ false };
+    };
+
+    //
+
+    // Owns everything and runs the frame loop.  It is also the observer the game rules talk
+    // to, passing the Board's changes on to the BoardView and turning everything else that
+    // happens into sounds and animations, except when headless where nobody is listening.
+    class GameCoordinator : public IGameObserver
     {
       public:
         GameCoordinator(const GameConfig & configOrig);
@@ -39,6 +59,26 @@ namespace snake
         void play(const GameConfig & config);
         void printDebugStatus();
 
+        // keys pressed on the given ticks counted from the start of each game, only used when
+        // headless and the key queue rules still apply, see HeadPiece::handleEvent()
+        void inputScript(const std::vector<TimedInput> & script) { m_inputScript = script; }
+
+        const std::vector<HeadlessGameResult> & headlessResults() const
+        {
+            return m_headlessResults;
+        }
+
+        // the next play() saves every key that reached the game to this file when it ends
+        void recordTo(const std::filesystem::path & path) { m_recordPathOpt = path; }
+
+        // The next play() plays the recording instead of the keyboard or the AI, with the
+        // recording's seed and GameConfig values, and says if it ended the same way.  Keys
+        // other than Escape are ignored, and when not headless GameConfig::sim_speed still
+        // applies so that it can be watched faster or slower.
+        void replay(const Recording & recording) { m_replayOpt = recording; }
+
+        Seed_t seed() const { return m_seed; }
+
       private:
         bool willContinue() const
         {
@@ -47,32 +87,119 @@ namespace snake
 
         void frameLoop();
         void setup(const GameConfig & config);
+        void setupHeadless();
+        IRegion & pickStatusRegion(const GameConfig & config);
+        IGameObserver & pickObserver(const GameConfig & config);
+
+        // no window, no frame clock, and one tick per pass until every game is over
+        void headlessLoop();
+        void handleHeadlessInput(const std::size_t gameStartTick, std::size_t & scriptIndex);
+        void printHeadlessSummary() const;
+
+        // records the keys that reach the game in play when recording
+        void passEventToState(const sf::Event & event);
+
+        // sends every recorded key polled on or before the current tick, until one of them
+        // changes the state
+        void handleReplayInput();
+
+        bool isRecording() const { return m_recordPathOpt.has_value(); }
+        bool isReplaying() const { return m_replayOpt.has_value(); }
+
+        // the tick a replay stops on if the game hasn't already ended by then
+        std::size_t replayTickLimit() const;
+
+        void saveRecording();
+        void printReplayResult() const;
+
         const sf::VideoMode pickResolution() const;
         void openWindow();
         void handlePeriodicTasks(sf::Clock & periodClock, std::size_t & frameCounter);
-        void handleEvents();
+        void handleEvents(const sf::Clock & frameClock);
+
+        // runs as many fixed ticks as fit in the time since the last frame, and keeps the
+        // leftover for next time
+        void simulate(const sf::Int64 elapsedMicroSec);
+
+        // whole microseconds so that float rounding can never add or lose a tick
+        sf::Int64 microSecPerTick() const
+        {
+            return static_cast<sf::Int64>(
+                1'000'000.0 /
+                (static_cast<double>(m_config.sim_ticks_per_sec) *
+                 static_cast<double>(m_config.sim_speed)));
+        }
+
         void update(const float elapsedSec);
         void draw();
 
+        // IGameObserver
+        void onBoardCleared() override;
+
+        void onCellChanged(
+            const std::size_t cellIndex,
+            const PieceEnumOpt_t & pieceBefore,
+            const PieceEnumOpt_t & pieceAfter,
+            const util::SlotHandle & owner) override;
+
+        void onPieceMoved(const std::size_t fromCellIndex, const std::size_t toCellIndex) override;
+        void onPlayerTailChanged() override;
+        void onBoardRestored() override;
+        void onLevelStarted(const std::size_t levelNumber) override;
+        void onInputQueued(const sf::Keyboard::Key key) override;
+        void onFoodMissed(const BoardPos_t & foodPos) override;
+
+        void onFoodEaten(
+            const BoardPos_t & pos, const int scoreEarned, const bool isLifeBonus) override;
+
+        void onSlowEaten(const BoardPos_t & pos) override;
+        void onShrinkEaten(const BoardPos_t & pos) override;
+        void onLifeLost(const Piece pieceBitten) override;
+        void onGameStatusChanged() override;
+
       private:
         GameConfig m_configOriginalCopy;
         GameConfig m_config;
         Layout m_layout;
+        PixelLayout m_pixelLayout;
         Media m_media;
         GameInPlay m_game;
         sf::RenderWindow m_window;
         std::unique_ptr<util::BloomEffectHelper> m_bloomWindow;
         Board m_board;
+        BoardView m_boardView;
         util::Random m_random;
+
+        // sounds and animations pick at random too, but never from m_random, so that only the
+        // game itself changes what m_random hands out next
+        util::Random m_presentationRandom;
+
         util::SoundPlayer m_soundPlayer;
         util::AnimationPlayer m_animationPlayer;
         Animations m_cellAnims;
         StatusRegion m_statusRegion;
+        NullRegion m_nullStatusRegion;
         StateMachine m_stateMachine;
         ScoreFile m_scoreFile;
-        Context m_context;
+        NullGameObserver m_nullObserver;
+        FrontEndContext m_context;
+
+        // rises with every food eaten during a level
+        float m_eatSfxPitch;
 
         sf::Clock m_runClock;
+        sf::Int64 m_simUnspentMicroSec;
+
+        std::vector<TimedInput> m_inputScript;
+        std::vector<HeadlessGameResult> m_headlessResults;
+
+        Seed_t m_seed;
+        std::optional<std::filesystem::path> m_recordPathOpt;
+        Recording m_recording;
+        std::optional<Recording> m_replayOpt;
+        std::size_t m_replayIndex;
+
+        static inline const sf::Vector2u m_headlessResolution{ 1920u, 1080u };
     };
 } // namespace snake
 
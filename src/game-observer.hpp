@@ -0,0 +1,102 @@
+#ifndef SNAKE_GAME_OBSERVER_HPP_INCLUDED
+#define SNAKE_GAME_OBSERVER_HPP_INCLUDED
+//
+// game-observer.hpp
+//
+#include "common-types.hpp"
+#include "pieces.hpp"
+#include "slot-map.hpp"
+
+#include <cstddef>
+
+namespace snake
+{
+    // Everything the game rules tell the outside world, all as plain data.  The rules never
+    // play a sound, start an animation, or touch a vertex themselves, they only call these, so
+    // the SFML front-end (see GameCoordinator and BoardView) turns them into sounds, animations,
+    // and quads, while tools that only simulate can pass a NullGameObserver.
+    struct IGameObserver
+    {
+        virtual ~IGameObserver() = default;
+
+        //
+        // the Board, where cellIndex is Layout::cellIndex()
+        //
+
+        // The Board was emptied all at once by Board::loadMap() without a call to
+        // onCellChanged() for every cell.
+        virtual void onBoardCleared() = 0;
+
+        // A piece was placed, removed, or replaced.  The owner is the piece after, heads own
+        // themselves and tails belong to their head, and it is empty for everything else.
+        virtual void onCellChanged(
+            const std::size_t cellIndex,
+            const PieceEnumOpt_t & pieceBefore,
+            const PieceEnumOpt_t & pieceAfter,
+            const util::SlotHandle & owner) = 0;
+
+        // a head moved and is still the same head, see Board::move()
+        virtual void
+            onPieceMoved(const std::size_t fromCellIndex, const std::size_t toCellIndex) = 0;
+
+        // the player's tail grew, shrank, or both during the same turn
+        virtual void onPlayerTailChanged() = 0;
+
+        // Board::restore() put back a snapshot, after calling onCellChanged() for every cell
+        // that was different, but the order of the player's tail might have changed too
+        virtual void onBoardRestored() = 0;
+
+        //
+        // the game being played, see GameInPlay
+        //
+
+        virtual void onLevelStarted(const std::size_t levelNumber) = 0;
+
+        // the player pressed a key that was queued as a turn, see HeadPiece::handleEvent()
+        virtual void onInputQueued(const sf::Keyboard::Key key) = 0;
+
+        // the player moved away from food that was right next to it
+        virtual void onFoodMissed(const BoardPos_t & foodPos) = 0;
+
+        virtual void
+            onFoodEaten(const BoardPos_t & pos, const int scoreEarned, const bool isLifeBonus) = 0;
+
+        virtual void onSlowEaten(const BoardPos_t & pos) = 0;
+        virtual void onShrinkEaten(const BoardPos_t & pos) = 0;
+
+        // the player ran into a lethal piece, which lives() already counts
+        virtual void onLifeLost(const Piece pieceBitten) = 0;
+
+        // the score, lives, or level changed
+        virtual void onGameStatusChanged() = 0;
+    };
+
+    //
+
+    // ignores everything, for simulating without a front-end
+    struct NullGameObserver final : public IGameObserver
+    {
+        void onBoardCleared() override {}
+
+        void onCellChanged(
+            const std::size_t,
+            const PieceEnumOpt_t &,
+            const PieceEnumOpt_t &,
+            const util::SlotHandle &) override
+        {}
+
+        void onPieceMoved(const std::size_t, const std::size_t) override {}
+        void onPlayerTailChanged() override {}
+        void onBoardRestored() override {}
+        void onLevelStarted(const std::size_t) override {}
+        void onInputQueued(const sf::Keyboard::Key) override {}
+        void onFoodMissed(const BoardPos_t &) override {}
+        void onFoodEaten(const BoardPos_t &, const int, const bool) override {}
+        void onSlowEaten(const BoardPos_t &) override {}
+        void onShrinkEaten(const BoardPos_t &) override {}
+        void onLifeLost(const Piece) override {}
+        void onGameStatusChanged() override {}
+    };
+} // namespace snake
+
+#endif // SNAKE_GAME_OBSERVER_HPP_INCLUDED
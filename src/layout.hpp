@@ -6,31 +6,76 @@
 #include "check-macros.hpp"
 #include "common-types.hpp"
 
+#include <array>
+#include <cstdint>
 #include <set>
 #include <string>
 #include <vector>
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/Keyboard.hpp>
 
 //
 
 namespace snake
 {
-    // Parameters that define how the board is divided into cells (square tiles).
+    // Parameters that define how the board is divided into cells (square tiles).  Only the cells
+    // are here, where they are drawn on the window is the front-end's PixelLayout.
     class Layout
     {
       public:
+        // The cell indexes around each cell, with the board wrapping around at the edges the same
+        // way the snake does, so every cell has all eight.  The first four are in neighbor_dirs
+        // order and the last four are the diagonals (UpLeft, UpRight, DownLeft, DownRight).
+        static inline const std::size_t neighbor4_count{ 4 };
+        static inline const std::size_t neighbor8_count{ 8 };
+        using Neighbors_t = std::array<std::uint32_t, neighbor8_count>;
+
+        static inline const std::array<sf::Keyboard::Key, neighbor4_count> neighbor_dirs{
+            sf::Keyboard::Up, sf::Keyboard::Down, sf::Keyboard::Left, sf::Keyboard::Right
+        };
+
         Layout() = default;
 
         void reset(const GameConfig & config);
 
         std::string toString() const;
 
-        sf::FloatRect cellBounds(const BoardPos_t & pos) const;
+        // Cells are square and sized from the window, so the resolution is what decides how many
+        // fit.  The PixelLayout uses the same two to place the board on the window.
+        static int cellSideLength(const GameConfig & config);
+        static sf::Vector2i boardFenceSize(const GameConfig & config);
+
         const std::set<BoardPos_t> & allValidPositions() const { return all_valid_positions; }
-        const std::vector<sf::Vertex> & cellVerts() const { return cell_quad_verts; }
         BoardPosOpt_t findWraparoundPos(const BoardPos_t & pos) const;
 
+        // row-major (y * cell_counts.x + x), pos must be valid, see isPositionValid()
+        std::size_t cellIndex(const BoardPos_t & pos) const
+        {
+            return static_cast<std::size_t>((pos.y * cell_counts.x) + pos.x);
+        }
+
+        BoardPos_t cellPosition(const std::size_t index) const
+        {
+            const int indexInt{ static_cast<int>(index) };
+            return { (indexInt % cell_counts.x), (indexInt / cell_counts.x) };
+        }
+
+        const Neighbors_t & neighbors(const std::size_t index) const { return m_neighbors[index]; }
+
+        // dir must be an arrow key and index must be valid
+        std::size_t neighborIndex(const std::size_t index, const sf::Keyboard::Key dir) const;
+
+        // the same as keys::move() followed by findWraparoundPos()
+        BoardPos_t neighborPos(const BoardPos_t & pos, const sf::Keyboard::Key dir) const
+        {
+            return cellPosition(neighborIndex(cellIndex(pos), dir));
+        }
+
+        // changes every time reset() is called, so anything drawn from the layout can tell
+        // when it needs to be drawn again
+        std::size_t revision() const { return m_revision; }
+
         template <typename T>
         bool isPositionValid(const sf::Vector2<T> & posOrig) const
         {
@@ -45,24 +90,9 @@ namespace snake
 
         //
 
-        sf::Vector2i window_size{ 0, 0 };
-        sf::Vector2f window_size_f{ 0.0f, 0.0f };
-        sf::IntRect window_bounds{ 0, 0, 0, 0 };
-        sf::FloatRect window_bounds_f{ 0.0f, 0.0f, 0.0f, 0.0f };
-        //
-        sf::Vector2i cell_size{ 0, 0 };
-        sf::Vector2i board_size{ 0, 0 };
         sf::Vector2i cell_counts{ 0, 0 };
         int cell_count_total{ 0 };
         std::size_t cell_count_total_st{ 0 };
-        sf::Vector2i top_left_pos{ 0, 0 };
-        sf::IntRect board_bounds{ 0, 0, 0, 0 };
-        sf::FloatRect board_bounds_f{ 0, 0, 0, 0 };
-
-        sf::IntRect status_bounds{ 0, 0, 0, 0 };
-        sf::FloatRect status_bounds_f{ 0.0f, 0.0f, 0.0f, 0.0f };
-
-        sf::IntRect cells_rect{ 0, 0, 0, 0 };
 
         BoardPosVec_t wall_positions_left;
         BoardPosVec_t wall_positions_right;
@@ -71,12 +101,13 @@ namespace snake
 
       private:
         void regionCalculations(const GameConfig & config);
-        void cellCalculations(const GameConfig & config);
+        void cellCalculations();
+        void neighborCalculations();
 
       private:
         std::set<BoardPos_t> all_valid_positions;
-        std::vector<sf::Vertex> cell_quad_verts;
-        std::vector<std::vector<sf::IntRect>> cell_bounds_lut;
+        std::vector<Neighbors_t> m_neighbors;
+        std::size_t m_revision{ 0 };
     };
 
 } // namespace snake
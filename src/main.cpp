@@ -3,10 +3,17 @@
 //
 // main.cpp
 //
+#include "batch-simulator.hpp"
+#include "board-benchmark.hpp"
+#include "difficulty-tuner.hpp"
 #include "game-coordinator.hpp"
+#include "recording.hpp"
 #include "settings.hpp"
+#include "vector-env.hpp"
 
 #include <cstddef>
+#include <cstdlib>
+#include <random>
 
 //
 // TODO
@@ -32,16 +39,132 @@ int main(const int argc, const char * const argv[])
     if (argc > 2)
     {
         config.will_limit_resolution = ("limit-resolution" == std::string{ argv[2] });
+
+        // "headless [game_count]" plays that many games with the AI and no window or sound
+        config.is_headless = ("headless" == std::string{ argv[2] });
+        config.will_ai_drive_player = config.is_headless;
+
+        if (config.is_headless && (argc > 3))
+        {
+            config.headless_game_count = static_cast<std::size_t>(std::atoll(argv[3]));
+        }
     }
 
+    // "batch [game_count] [thread_count] [seed]" plays that many games with the AI across that
+    // many threads (zero means one per core) and prints how each went
+    const bool isBatch{ (argc > 2) && ("batch" == std::string{ argv[2] }) };
+
+    // "vector-env [env_count] [step_count] [seed]" steps that many small boards together with
+    // random keys to see how many env-steps per second a bot could be trained with
+    const bool isVectorEnv{ (argc > 2) && ("vector-env" == std::string{ argv[2] }) };
+
+    // "bench-snapshot [tick_count] [seed]" times Board snapshots and rewinds while the AI plays
+    const bool isBenchSnapshot{ (argc > 2) && ("bench-snapshot" == std::string{ argv[2] }) };
+
+    // "bench-lookup [tick_count] [seed]" times finding pieces in the Board's grid and in a map
+    const bool isBenchLookup{ (argc > 2) && ("bench-lookup" == std::string{ argv[2] }) };
+
+    // "bench-distance [tick_count] [seed]" times finding free cells a distance from the player
+    const bool isBenchDistance{ (argc > 2) && ("bench-distance" == std::string{ argv[2] }) };
+
+    // "tune [games_per_point] [iteration_count] [thread_count] [seed]" searches for the level
+    // difficulty where 85% of the AI's games that start a level make it to the next
+    const bool isTune{ (argc > 2) && ("tune" == std::string{ argv[2] }) };
+
+    // "record <file>" plays normally and saves every key to the file when the game ends
+    const bool isRecord{ (argc > 3) && ("record" == std::string{ argv[2] }) };
+
+    // "replay <file> [speed]" plays a recorded game again, where zero speed means headless
+    const bool isReplay{ (argc > 3) && ("replay" == std::string{ argv[2] }) };
+
     config.frame_rate_limit = 0;
     config.is_god_mode = false;
     config.will_show_fps = true;
 
+    const auto argOr = [&](const int index, const std::size_t defaultValue) {
+        return ((argc > index) ? static_cast<std::size_t>(std::atoll(argv[index])) : defaultValue);
+    };
+
     try
     {
-        GameCoordinator game(config);
-        game.play();
+        if (isTune)
+        {
+            DifficultyTuner tuner(
+                config,
+                DifficultyTuner::makeTargetCurve(10, 0.85f),
+                argOr(3, 1000),
+                argOr(5, 0),
+                static_cast<Seed_t>(argOr(6, std::random_device{}())));
+
+            tuner.tune(argOr(4, 50));
+        }
+        else if (isVectorEnv)
+        {
+            // bigger cells on the same resolution makes for fewer of them
+            config.cell_size_window_ratio = 0.05f;
+
+            const Seed_t seed{ static_cast<Seed_t>(argOr(5, std::random_device{}())) };
+            VectorEnv env(config, argOr(3, 1024), seed);
+            env.benchmark(argOr(4, 1000), seed);
+        }
+        else if (isBenchSnapshot)
+        {
+            BoardBenchmark benchmark(config);
+
+            benchmark.snapshots(
+                argOr(3, 100000), static_cast<Seed_t>(argOr(4, std::random_device{}())));
+        }
+        else if (isBenchLookup)
+        {
+            BoardBenchmark benchmark(config);
+
+            benchmark.cellLookups(
+                argOr(3, 100000), static_cast<Seed_t>(argOr(4, std::random_device{}())));
+        }
+        else if (isBenchDistance)
+        {
+            BoardBenchmark benchmark(config);
+
+            benchmark.distanceQueries(
+                argOr(3, 10000), static_cast<Seed_t>(argOr(4, std::random_device{}())));
+        }
+        else if (isBatch)
+        {
+            BatchSimulator batch(config);
+
+            batch.run(
+                argOr(3, 1000), argOr(4, 0), static_cast<Seed_t>(argOr(5, std::random_device{}())));
+
+            batch.printResults();
+            batch.printSummary();
+        }
+        else if (isRecord)
+        {
+            GameCoordinator game(config);
+            game.recordTo(argv[3]);
+            game.play();
+        }
+        else if (isReplay)
+        {
+            const Recording recording{ Recording::load(argv[3]) };
+
+            config.sim_speed = ((argc > 4) ? static_cast<float>(std::atof(argv[4])) : 1.0f);
+            config.is_headless = (config.sim_speed <= 0.0f);
+
+            if (config.is_headless)
+            {
+                config.sim_speed = 1.0f;
+            }
+
+            GameCoordinator game(config);
+            game.replay(recording);
+            game.play();
+        }
+        else
+        {
+            GameCoordinator game(config);
+            game.play();
+        }
     }
     catch (const std::exception & ex)
     {
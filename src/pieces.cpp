@@ -6,24 +6,26 @@
 #include "pieces.hpp"
 
 #include "board.hpp"
-#include "cell-animations.hpp"
 #include "context.hpp"
+#include "game-observer.hpp"
 #include "layout.hpp"
 #include "random.hpp"
 #include "settings.hpp"
-#include "sound-player.hpp"
-#include "states.hpp"
 #include "util.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
 namespace snake
 {
     PieceBase::PieceBase(
-        Context &, const Piece piece, const BoardPos_t & pos, const float timeBetweenTurnsSec)
+        Context &, const Piece piece, const BoardPos_t & pos, const std::size_t ticksPerTurn)
         : m_piece(piece)
-        , m_color(piece::toColor(piece))
         , m_position(pos)
-        , m_turnDurationSec(timeBetweenTurnsSec)
-        , m_turnElapsedSec(0.0f)
+        , m_positionPrev(pos)
+        , m_ticksPerTurn(std::max(1_st, ticksPerTurn))
+        , m_ticksSinceTurn(0)
     {}
 
     std::string PieceBase::toString() const
@@ -32,9 +34,8 @@ namespace snake
 
         ss << piece::toString(m_piece) << " Piece:";
         ss << "\n\t position            = " << position();
-        ss << "\n\t color               = " << color();
-        ss << "\n\t turn_duration_sec   = " << m_turnDurationSec;
-        ss << "\n\t turn_elapsed_sec    = " << m_turnElapsedSec;
+        ss << "\n\t ticks_per_turn      = " << m_ticksPerTurn;
+        ss << "\n\t ticks_since_turn    = " << m_ticksSinceTurn;
 
         return ss.str();
     }
@@ -42,58 +43,68 @@ namespace snake
     void PieceBase::position(Context & context, const BoardPos_t & newPosition)
     {
         // Board::move() might change the given newPosition because of wrap around
+        m_positionPrev = m_position;
         m_position = context.board.move(context, position(), newPosition);
     }
 
-    void PieceBase::color(Context & context, const sf::Color & newColor)
+    bool PieceBase::advanceTurnClock()
     {
-        context.board.colorQuad(position(), newColor);
-        m_color = newColor;
+        if (++m_ticksSinceTurn < m_ticksPerTurn)
+        {
+            return false;
+        }
+
+        m_ticksSinceTurn = 0;
+        return true;
     }
 
-    void PieceBase::update(Context & context, const float elapsedSec)
+    void PieceBase::skipTicks(const std::size_t tickCount)
     {
-        if (m_turnDurationSec < 0.0f)
-        {
-            takeTurn(context);
-        }
-        else
-        {
-            m_turnElapsedSec += elapsedSec;
-            while (m_turnElapsedSec > m_turnDurationSec)
-            {
-                takeTurn(context);
-                m_turnElapsedSec -= m_turnDurationSec;
-            }
-        }
+        M_CHECK_SS(
+            (tickCount < ticksUntilTurn()),
+            "tickCount=" << tickCount << ", ticksUntilTurn()=" << ticksUntilTurn());
+
+        m_ticksSinceTurn += tickCount;
     }
 
-    //
+    float PieceBase::turnProgressRatio(const float tickRatio) const
+    {
+        const float ratio{ (static_cast<float>(m_ticksSinceTurn) + tickRatio) /
+                           static_cast<float>(m_ticksPerTurn) };
 
-    FoodPiece::FoodPiece(Context & context, const BoardPos_t & pos)
-        : PieceBase(context, Piece::Food, pos, -1.0f)
-    {}
+        return std::clamp(ratio, 0.0f, 1.0f);
+    }
 
     //
 
-    HeadPiece::HeadPiece(Context & context, const BoardPos_t & pos)
-        : PieceBase(context, Piece::Head, pos, context.game.level().sec_per_turn_current)
+    HeadPiece::HeadPiece(Context & context, const BoardPos_t & pos, const bool isPlayer)
+        : PieceBase(
+              context,
+              Piece::Head,
+              pos,
+              context.config.secToTicks(context.game.level().sec_per_turn_current))
         , m_directionPrev(keys::not_a_key)
         , m_directionNext(keys::not_a_key)
-        , m_directionNextNext(keys::not_a_key)
+        , m_inputQueue()
         , m_tailGrowRemainingCount(context.game.level().tail_start_length)
+        , m_isPlayer(isPlayer)
+        , m_handle()
     {
         const sf::Keyboard::Key initialRandomDirection{ context.random.from(
             { sf::Keyboard::Up, sf::Keyboard::Down, sf::Keyboard::Left, sf::Keyboard::Right }) };
 
         m_directionPrev = initialRandomDirection;
         m_directionNext = initialRandomDirection;
-        m_directionNextNext = keys::not_a_key;
+    }
+
+    bool HeadPiece::isAiDriven(const Context & context) const
+    {
+        return (!m_isPlayer || context.config.will_ai_drive_player);
     }
 
     void HeadPiece::handleEvent(Context & context, const sf::Event & event)
     {
-        if (sf::Event::KeyPressed != event.type)
+        if ((sf::Event::KeyPressed != event.type) || isAiDriven(context))
         {
             return;
         }
@@ -104,61 +115,120 @@ namespace snake
             return;
         }
 
-        if (keys::not_a_key == m_directionNext)
+        // every queued key has to turn from the one queued before it
+        const sf::Keyboard::Key keyBefore{ (m_inputQueue.empty()) ? m_directionPrev
+                                                                   : m_inputQueue.back().key };
+
+        if (key == keyBefore)
         {
-            if (keys::isLateral(key, m_directionPrev))
-            {
-                m_directionNext = key;
-                m_directionNextNext = keys::not_a_key;
-                context.audio.play("tap-1-a.ogg");
-            }
+            ++context.input_coalesced_count;
+            return;
+        }
 
+        if (!keys::isLateral(key, keyBefore) ||
+            (m_inputQueue.size() >= context.config.input_queue_depth))
+        {
+            ++context.input_dropped_count;
             return;
         }
 
-        if (keys::not_a_key == m_directionNextNext)
+        m_inputQueue.push_back({ key, context.input_tick });
+        context.observer.onInputQueued(key);
+    }
+
+    void HeadPiece::takeQueuedInput(const Context & context)
+    {
+        // a key pressed after the tick of this turn waits for the next turn, so two quick
+        // presses always land on two turns in a row instead of on the same one or one late
+        m_directionNext = keys::not_a_key;
+
+        if (!m_inputQueue.empty() && (m_inputQueue.front().tick <= context.sim_tick_count))
         {
-            if (keys::isLateral(key, m_directionNext))
-            {
-                m_directionNextNext = key;
-                context.audio.play("tap-1-a.ogg");
-            }
+            m_directionNext = m_inputQueue.front().key;
+            m_inputQueue.pop_front();
+        }
+    }
 
-            return;
+    BoardPos_t HeadPiece::planMove(Context & context)
+    {
+        if (isAiDriven(context))
+        {
+            chooseAiDirection(context);
+        }
+        else
+        {
+            takeQueuedInput(context);
         }
+
+        finalizeDirectionToMove(context);
+
+        // wraps around if it walked off the board
+        const BoardPos_t oldPos{ position() };
+        const BoardPos_t newPos{ context.layout.neighborPos(oldPos, m_directionNext) };
+
+        M_CHECK_SS((newPos != oldPos), "oldPos=" << oldPos << ", newPos=" << newPos);
+        return newPos;
     }
 
-    auto HeadPiece::move(Context & context)
+    void HeadPiece::chooseAiDirection(const Context & context)
     {
+        // head for the closest food, but never into anything that kills
         const BoardPos_t oldPos{ position() };
-        BoardPos_t newPos{ keys::move(oldPos, m_directionNext) };
 
-        // check if walked off the board
-        const BoardPosOpt_t wrapPosOpt{ context.layout.findWraparoundPos(newPos) };
-        if (wrapPosOpt)
+        BoardPos_t targetPos{ oldPos };
+        int targetDistance{ std::numeric_limits<int>::max() };
+        for (const BoardPos_t & foodPos : context.board.foodPositions())
         {
-            newPos = wrapPosOpt.value();
+            const int distance{ std::abs(foodPos.x - oldPos.x) + std::abs(foodPos.y - oldPos.y) };
+            if (distance < targetDistance)
+            {
+                targetPos = foodPos;
+                targetDistance = distance;
+            }
         }
 
-        M_CHECK_SS((newPos != oldPos), "oldPos=" << oldPos << ", newPos=" << newPos);
+        sf::Keyboard::Key bestDir{ m_directionPrev };
+        int bestDistance{ std::numeric_limits<int>::max() };
+        for (const sf::Keyboard::Key dir :
+             { sf::Keyboard::Up, sf::Keyboard::Down, sf::Keyboard::Left, sf::Keyboard::Right })
+        {
+            if (keys::isOpposite(dir, m_directionPrev))
+            {
+                continue;
+            }
 
+            const BoardPos_t pos{ context.layout.neighborPos(oldPos, dir) };
+            const PieceEnumOpt_t pieceOpt{ context.board.pieceEnumOptAt(pos) };
+            if (pieceOpt && piece::isLethal(pieceOpt.value()))
+            {
+                continue;
+            }
+
+            const int distance{ std::abs(targetPos.x - pos.x) + std::abs(targetPos.y - pos.y) };
+            if (distance < bestDistance)
+            {
+                bestDir = dir;
+                bestDistance = distance;
+            }
+        }
+
+        m_directionNext = bestDir;
+    }
+
+    auto HeadPiece::move(Context & context, const BoardPos_t & newPos)
+    {
+        const BoardPos_t oldPos{ position() };
         const PieceEnumOpt_t newPosEnumOpt{ context.board.pieceEnumOptAt(newPos) };
 
         // check for miss must occur here before things move around
-        if (!newPosEnumOpt)
+        if (m_isPlayer && !newPosEnumOpt)
         {
-            const Surroundings oldSurr{ context.board.surroundings(oldPos) };
-            const Surroundings newSurr{ context.board.surroundings(newPos) };
+            const Surroundings oldSurr{ context.board.surroundings(context, oldPos) };
+            const Surroundings newSurr{ context.board.surroundings(context, newPos) };
 
             if ((oldSurr.pieceCount(Piece::Food) > 0) && (newSurr.pieceCount(Piece::Food) == 0))
             {
-                context.audio.play("miss");
-
-                context.cell_anims.addRisingText(
-                    context,
-                    "miss",
-                    context.config.grow_fade_text_color,
-                    context.layout.cellBounds(oldSurr.posOfPiece(Piece::Food)));
+                context.observer.onFoodMissed(oldSurr.posOfPiece(Piece::Food));
             }
         }
 
@@ -168,6 +238,17 @@ namespace snake
 
     void HeadPiece::handlePickup(Context & context, const BoardPos_t & posEaten, const Piece piece)
     {
+        // rivals only grow, they never score or change the speed, and never get here if lethal
+        if (!m_isPlayer)
+        {
+            if (Piece::Food == piece)
+            {
+                m_tailGrowRemainingCount += context.game.level().tail_grow_after_eat;
+            }
+
+            return;
+        }
+
         context.game.handlePickup(context, posEaten, piece);
 
         if (!context.game.isGameOver())
@@ -177,7 +258,7 @@ namespace snake
                 m_tailGrowRemainingCount += context.game.level().tail_grow_after_eat;
             }
 
-            turnDurationSec(context.game.level().sec_per_turn_current);
+            ticksPerTurn(context.config.secToTicks(context.game.level().sec_per_turn_current));
         }
     }
 
@@ -189,24 +270,20 @@ namespace snake
         }
         else
         {
-            context.board.removePiece(context, context.board.findLastTailPiecePos());
+            context.board.removePiece(context, context.board.findLastTailPiecePos(m_handle));
         }
 
-        context.board.reColorTailPieces(context);
-    }
-
-    void HeadPiece::takeTurn(Context & context)
-    {
-        if (context.game.isGameOver())
+        if (m_isPlayer)
         {
-            return;
+            context.observer.onPlayerTailChanged();
         }
+    }
 
-        finalizeDirectionToMove(context);
-
-        const auto [oldPos, newPos, newPosEnumOpt] = move(context);
+    void HeadPiece::takeTurn(Context & context, const BoardPos_t & newPosToMove)
+    {
+        const auto [oldPos, newPos, newPosEnumOpt] = move(context, newPosToMove);
 
-        context.board.replaceWithNewPiece(context, Piece::Tail, oldPos);
+        context.board.replaceWithNewPiece(context, Piece::Tail, oldPos, m_handle);
 
         // handlePickup() must occur before handleTailAfterMove() to keep
         // m_tailGrowRemainingCount in sync
@@ -218,49 +295,23 @@ namespace snake
         handleTailAfterMove(context);
 
         m_directionPrev = m_directionNext;
-        m_directionNext = m_directionNextNext;
-        m_directionNextNext = keys::not_a_key;
+        m_directionNext = keys::not_a_key;
     }
 
     void HeadPiece::finalizeDirectionToMove(const Context &)
     {
         M_CHECK_SS(keys::isArrow(m_directionPrev), m_directionPrev);
 
-        if (m_directionNext == m_directionNextNext)
-        {
-            M_CHECK_SS(
-                (m_directionNext == keys::not_a_key),
-                "(1)m_directionNext=" << m_directionNext
-                                      << ", m_directionNextNext=" << m_directionNextNext);
-        }
-
-        //  reversing direction leading to instant death should be prevented elsewhere
-        M_CHECK_SS(
-            (keys::opposite(m_directionNext) != m_directionPrev),
-            "(1)Reverse direction move detected: m_directionPrev="
-                << m_directionPrev << ", m_directionNext=" << m_directionNext
-                << ", m_directionNextNext=" << m_directionNext);
-
         if (!keys::isArrow(m_directionNext))
         {
             m_directionNext = m_directionPrev;
-            m_directionNextNext = keys::not_a_key;
-        }
-
-        if (m_directionNext == m_directionNextNext)
-        {
-            M_CHECK_SS(
-                (m_directionNext == keys::not_a_key),
-                "(2)m_directionNext=" << m_directionNext
-                                      << ", m_directionNextNext=" << m_directionNextNext);
         }
 
         //  reversing direction leading to instant death should be prevented elsewhere
         M_CHECK_SS(
             (keys::opposite(m_directionNext) != m_directionPrev),
-            "(2)Reverse direction move detected: m_directionPrev="
-                << m_directionPrev << ", m_directionNext=" << m_directionNext
-                << ", m_directionNextNext=" << m_directionNext);
+            "Reverse direction move detected: m_directionPrev="
+                << m_directionPrev << ", m_directionNext=" << m_directionNext);
     }
 
     //
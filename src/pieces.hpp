@@ -6,13 +6,16 @@
 //
 #include "common-types.hpp"
 #include "keys.hpp"
+#include "ring-buffer.hpp"
+#include "slot-map.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <optional>
 #include <ostream>
 #include <string>
 #include <vector>
 
-#include <SFML/Graphics/Color.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Window/Event.hpp>
 
@@ -39,6 +42,13 @@ namespace snake
         bool wrapped_around_board{ false };
     };
 
+    // an arrow key and the simulation tick it was pressed during, see HeadPiece::handleEvent()
+    struct TimedInput
+    {
+        sf::Keyboard::Key key;
+        std::size_t tick;
+    };
+
     //
     struct PosInfo
     {
@@ -68,7 +78,7 @@ namespace snake
             Context & context,
             const Piece piece,
             const BoardPos_t & pos,
-            const float timeBetweenTurnsSec = -1.0f); // see comment below
+            const std::size_t ticksPerTurn = 1);
 
       public:
         virtual ~PieceBase() = default;
@@ -80,117 +90,93 @@ namespace snake
         inline const BoardPos_t position() const { return m_position; }
         void position(Context & context, const BoardPos_t & newPosition);
 
-        inline const sf::Color & color() const { return m_color; }
-        void color(Context & context, const sf::Color & newColor);
-
-        float turnDurationSec() const { return m_turnDurationSec; }
-        void turnDurationSec(const float seconds) { m_turnDurationSec = seconds; }
+        // where it was before the last move, only used to draw the slide between the two
+        inline const BoardPos_t positionPrev() const { return m_positionPrev; }
 
-        virtual void update(Context &, const float elapsedSec);
-        virtual void handleEvent(Context &, const sf::Event &) {}
-        virtual void takeTurn(Context &) {}
-
-      private:
-        Piece m_piece;
-        sf::Color m_color;
-        BoardPos_t m_position;
-
-        float m_turnDurationSec; // negative means this piece takes one turn per frame/update()
-        float m_turnElapsedSec;
-    };
-
-    //
-
-    struct WallPiece : public PieceBase
-    {
-        WallPiece(Context & context, const BoardPos_t & pos)
-            : PieceBase(context, Piece::Wall, pos)
-        {}
-
-        virtual ~WallPiece() override = default;
-
-        void update(Context &, const float) override {}
-    };
-
-    //
-
-    struct FoodPiece : public PieceBase
-    {
-        FoodPiece(Context & context, const BoardPos_t & pos);
-        virtual ~FoodPiece() override = default;
-
-        void update(Context &, const float) override {}
-    };
-
-    //
+        std::size_t ticksPerTurn() const { return m_ticksPerTurn; }
+        void ticksPerTurn(const std::size_t ticks)
+        {
+            m_ticksPerTurn = std::max(std::size_t(1), ticks);
+        }
 
-    struct ShrinkPiece : public PieceBase
-    {
-        ShrinkPiece(Context & context, const BoardPos_t & pos)
-            : PieceBase(context, Piece::Shrink, pos)
-        {}
+        // counts one simulation tick and returns true if a turn is now due, see Board::tick()
+        bool advanceTurnClock();
 
-        virtual ~ShrinkPiece() override = default;
+        // how many more advanceTurnClock() calls until one returns true, always at least one
+        std::size_t ticksUntilTurn() const
+        {
+            return ((m_ticksSinceTurn < m_ticksPerTurn) ? (m_ticksPerTurn - m_ticksSinceTurn)
+                                                        : 1);
+        }
 
-        void update(Context &, const float) override {}
-    };
+        // the same as that many advanceTurnClock() calls that all return false
+        void skipTicks(const std::size_t tickCount);
 
-    //
+        // 0 right after a turn and 1 when the next one is due, where tickRatio is how far the
+        // frame being drawn is into the next tick, see Context::sim_tick_ratio
+        float turnProgressRatio(const float tickRatio) const;
 
-    struct SlowPiece : public PieceBase
-    {
-        SlowPiece(Context & context, const BoardPos_t & pos)
-            : PieceBase(context, Piece::Slow, pos)
-        {}
+        virtual void handleEvent(Context &, const sf::Event &) {}
 
-        virtual ~SlowPiece() override = default;
+      private:
+        Piece m_piece;
+        BoardPos_t m_position;
+        BoardPos_t m_positionPrev;
 
-        void update(Context &, const float) override {}
+        // whole ticks instead of seconds so that turns never drift with the frame rate
+        std::size_t m_ticksPerTurn;
+        std::size_t m_ticksSinceTurn;
     };
 
     //
 
-    struct TailPiece : public PieceBase
+    // The only piece that is an object, because it is the only one that ever takes a turn.
+    // Every other piece is just a Piece in the Board's grid, and only BoardView knows its color.
+    // There is one player snake that plays the game (score, lives, levels) and any number of
+    // rival snakes that only get in the way.  Rivals are always driven by the AI, and so is
+    // the player if GameConfig::will_ai_drive_player is set.
+    struct HeadPiece final : public PieceBase
     {
-        TailPiece(Context & context, const BoardPos_t & pos)
-            : PieceBase(context, Piece::Tail, pos)
-        {}
-
-        virtual ~TailPiece() override = default;
-
-        void update(Context &, const float) override {}
+        HeadPiece(Context & context, const BoardPos_t & pos, const bool isPlayer);
+        virtual ~HeadPiece() override = default;
 
-        static inline sf::Color m_colorLight{ 64, 255, 0 };
+        void handleEvent(Context & context, const sf::Event & event) override;
 
-        static inline sf::Color m_colorDark{ static_cast<sf::Uint8>(m_colorLight.r / 4),
-                                             static_cast<sf::Uint8>(m_colorLight.g / 4),
-                                             static_cast<sf::Uint8>(m_colorLight.b / 4) };
-    };
+        // Board::tick() splits each turn in two so that every head can pick where it is going
+        // before any of them move, and so that heads colliding with each other can be found
+        BoardPos_t planMove(Context & context);
+        void takeTurn(Context & context, const BoardPos_t & newPos);
 
-    //
+        void resetTailGrowCounter() { m_tailGrowRemainingCount = 0; }
 
-    struct HeadPiece : public PieceBase
-    {
-        HeadPiece(Context & context, const BoardPos_t & pos);
-        virtual ~HeadPiece() override = default;
+        bool isPlayer() const { return m_isPlayer; }
+        bool isAiDriven(const Context & context) const;
 
-        // void update(Context &, const float elapsedSec) override;
-        void handleEvent(Context & context, const sf::Event & event) override;
-        void takeTurn(Context & context) override;
-        void resetTailGrowCounter() { m_tailGrowRemainingCount = 0; }
+        // the handle Board::m_headPieces holds this under, which is also what owns the tail
+        const util::SlotHandle & handle() const { return m_handle; }
+        void handle(const util::SlotHandle & newHandle) { m_handle = newHandle; }
 
       private:
+        void chooseAiDirection(const Context & context);
+        void takeQueuedInput(const Context & context);
         void finalizeDirectionToMove(const Context & context);
-        auto move(Context & context);
+        auto move(Context & context, const BoardPos_t & newPos);
         void handleTailAfterMove(Context & context);
         void handlePickup(Context &, const BoardPos_t & newPos, const Piece piece);
 
       protected:
         sf::Keyboard::Key m_directionPrev;
         sf::Keyboard::Key m_directionNext;
-        sf::Keyboard::Key m_directionNextNext;
+
+        // Keys are queued with the tick they were pressed during (Context::input_tick) as soon
+        // as they are polled, and each turn takes at most one that was pressed by then.  Holds
+        // at most GameConfig::input_queue_depth, and only ever allocates the first time.
+        util::RingBuffer<TimedInput> m_inputQueue;
 
         std::size_t m_tailGrowRemainingCount;
+
+        bool m_isPlayer;
+        util::SlotHandle m_handle;
     };
 
     //
@@ -211,18 +197,18 @@ namespace snake
             }
         }
 
-        inline sf::Color toColor(const Piece piece)
+        // how many Piece enums there are, for arrays indexed by toIndex()
+        constexpr std::size_t count{ static_cast<std::size_t>(Piece::Shrink) + 1 };
+
+        inline constexpr std::size_t toIndex(const Piece piece)
         {
-            switch (piece)
-            {
-                case Piece::Head: return sf::Color::Green;
-                case Piece::Tail: return TailPiece::m_colorLight;
-                case Piece::Food: return sf::Color::Yellow;
-                case Piece::Wall: return sf::Color(105, 70, 35);
-                case Piece::Slow: return sf::Color::Cyan;
-                case Piece::Shrink: return sf::Color::Magenta;
-                default: return sf::Color::Transparent;
-            }
+            return static_cast<std::size_t>(piece);
+        }
+
+        // what a head dies running into
+        inline constexpr bool isLethal(const Piece piece)
+        {
+            return ((Piece::Wall == piece) || (Piece::Tail == piece) || (Piece::Head == piece));
         }
     } // namespace piece
 
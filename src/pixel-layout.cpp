@@ -0,0 +1,156 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// pixel-layout.cpp
+//
+#include "pixel-layout.hpp"
+
+#include "check-macros.hpp"
+#include "graphics-util.hpp"
+#include "layout.hpp"
+#include "settings.hpp"
+
+#include <sstream>
+
+namespace snake
+{
+    void PixelLayout::reset(const GameConfig & config, const Layout & layout)
+    {
+        window_size = { 0, 0 };
+        window_size_f = { 0.0f, 0.0f };
+        window_bounds = { 0, 0, 0, 0 };
+        window_bounds_f = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        cell_size = { 0, 0 };
+        board_size = { 0, 0 };
+        top_left_pos = { 0, 0 };
+        board_bounds = { 0, 0, 0, 0 };
+        board_bounds_f = { 0, 0, 0, 0 };
+
+        status_bounds = { 0, 0, 0, 0 };
+        status_bounds_f = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        cell_counts = layout.cell_counts;
+        cell_bounds_lut.clear();
+
+        regionCalculations(config, layout);
+        cellCalculations(config);
+    }
+
+    void PixelLayout::regionCalculations(const GameConfig & config, const Layout & layout)
+    {
+        window_size = sf::Vector2i{ config.resolution };
+        window_size_f = sf::Vector2f{ window_size };
+
+        window_bounds = sf::IntRect({ 0, 0 }, window_size);
+        window_bounds_f = sf::FloatRect(window_bounds);
+
+        const int cellSideLength{ Layout::cellSideLength(config) };
+        cell_size.x = cellSideLength;
+        cell_size.y = cellSideLength;
+
+        const sf::Vector2i boardFenceSize{ Layout::boardFenceSize(config) };
+
+        board_size = (layout.cell_counts * cell_size);
+
+        M_CHECK_SS(
+            ((board_size.x <= window_size.x) && (board_size.y <= window_size.y)),
+            "board_size=" << board_size << ", windowSizeInt=" << window_size);
+
+        M_CHECK_SS(
+            ((board_size.x <= boardFenceSize.x) && (board_size.y <= boardFenceSize.y)),
+            "board_size=" << board_size << ", boardFenceSize=" << boardFenceSize);
+
+        top_left_pos = ((boardFenceSize - board_size) / 2);
+        top_left_pos.y = top_left_pos.x;
+
+        board_bounds = sf::IntRect(top_left_pos, board_size);
+        board_bounds_f = sf::FloatRect{ board_bounds };
+
+        M_CHECK_SS(
+            ((board_bounds.left >= 0) && (board_bounds.top >= 0) && (board_bounds.width > 0) &&
+             (board_bounds.height > 0)),
+            board_bounds);
+
+        status_bounds.left = 0;
+        status_bounds.width = window_size.x;
+        status_bounds.top = util::bottom(board_bounds) + cell_size.y + 1;
+        status_bounds.height = (window_size.y - status_bounds.top - 1);
+
+        status_bounds_f = sf::FloatRect(status_bounds);
+
+        // ...and now flip it so the status region is on top...
+        status_bounds.top = 0;
+        status_bounds_f = sf::FloatRect(status_bounds);
+
+        const int newBoardTop{ (window_size.y - board_size.y) - board_bounds.left };
+        top_left_pos.y = newBoardTop;
+        board_bounds.top = newBoardTop;
+        board_bounds_f = sf::FloatRect{ board_bounds };
+        status_bounds.height = (board_bounds.top - 1);
+        status_bounds_f = sf::FloatRect(status_bounds);
+    }
+
+    void PixelLayout::cellCalculations(const GameConfig & config)
+    {
+        cell_bounds_lut.clear();
+
+        cell_bounds_lut.resize(
+            static_cast<std::size_t>(cell_counts.y),
+            std::vector<sf::IntRect>(static_cast<std::size_t>(cell_counts.x), sf::IntRect{}));
+
+        for (int vert(0); vert < cell_counts.y; ++vert)
+        {
+            for (int horiz(0); horiz < cell_counts.x; ++horiz)
+            {
+                const BoardPos_t pos{ horiz, vert };
+
+                sf::IntRect bounds{ (top_left_pos + (pos * cell_size)), cell_size };
+
+                //
+                if (config.will_put_black_border_around_cells)
+                {
+                    ++bounds.left;
+                    ++bounds.top;
+                    bounds.width -= 2;
+                    bounds.height -= 2;
+                }
+
+                M_CHECK_SS(
+                    ((bounds.left >= 0) && (bounds.top >= 0) && (bounds.width > 1) &&
+                     (bounds.height > 1)),
+                    "board_pos=" << pos << ", cell_bounds=" << bounds);
+
+                //
+                const sf::Vector2s posST(pos);
+                cell_bounds_lut[posST.y][posST.x] = bounds;
+            }
+        }
+    }
+
+    std::string PixelLayout::toString() const
+    {
+        std::ostringstream ss;
+
+        ss << "PixelLayout:";
+        ss << "\n  window_bounds    = " << window_bounds << '/' << window_bounds_f;
+        ss << "\n  board_bounds     = " << board_bounds << '/' << board_bounds_f;
+        ss << "\n  status_bounds    = " << status_bounds << '/' << status_bounds_f;
+        ss << "\n  top_left_pos     = " << top_left_pos;
+        ss << "\n  cell_size        = " << cell_size;
+
+        return ss.str();
+    }
+
+    sf::FloatRect PixelLayout::cellBounds(const BoardPos_t & pos) const
+    {
+        if ((pos.x < 0) || (pos.y < 0) || (pos.x >= cell_counts.x) || (pos.y >= cell_counts.y))
+        {
+            return { 0.0f, 0.0f, 0.0f, 0.0f };
+        }
+
+        const sf::Vector2s posST{ pos };
+        return sf::FloatRect{ cell_bounds_lut[posST.y][posST.x] };
+    }
+
+} // namespace snake
@@ -0,0 +1,61 @@
+#ifndef SNAKE_PIXEL_LAYOUT_HPP_INCLUDED
+#define SNAKE_PIXEL_LAYOUT_HPP_INCLUDED
+//
+// pixel-layout.hpp
+//
+#include "common-types.hpp"
+
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+//
+
+namespace snake
+{
+    class Layout;
+
+    // Where the board, status region, and every cell of the Layout are drawn on the window.
+    // Only the front-end needs any of this, so only the FrontEndContext has one.
+    class PixelLayout
+    {
+      public:
+        PixelLayout() = default;
+
+        // the Layout has to be reset() first with the same config
+        void reset(const GameConfig & config, const Layout & layout);
+
+        std::string toString() const;
+
+        sf::FloatRect cellBounds(const BoardPos_t & pos) const;
+
+        //
+
+        sf::Vector2i window_size{ 0, 0 };
+        sf::Vector2f window_size_f{ 0.0f, 0.0f };
+        sf::IntRect window_bounds{ 0, 0, 0, 0 };
+        sf::FloatRect window_bounds_f{ 0.0f, 0.0f, 0.0f, 0.0f };
+        //
+        sf::Vector2i cell_size{ 0, 0 };
+        sf::Vector2i board_size{ 0, 0 };
+        sf::Vector2i top_left_pos{ 0, 0 };
+        sf::IntRect board_bounds{ 0, 0, 0, 0 };
+        sf::FloatRect board_bounds_f{ 0, 0, 0, 0 };
+
+        sf::IntRect status_bounds{ 0, 0, 0, 0 };
+        sf::FloatRect status_bounds_f{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+      private:
+        void regionCalculations(const GameConfig & config, const Layout & layout);
+        void cellCalculations(const GameConfig & config);
+
+      private:
+        sf::Vector2i cell_counts{ 0, 0 };
+        std::vector<std::vector<sf::IntRect>> cell_bounds_lut;
+    };
+
+} // namespace snake
+
+#endif // SNAKE_PIXEL_LAYOUT_HPP_INCLUDED
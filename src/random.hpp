@@ -21,6 +21,19 @@ namespace util
 
         explicit Random(const std::random_device::result_type seed)
             : m_engine()
+        {
+            reseed(seed);
+        }
+
+        // prevent all copy and assignment
+        Random(const Random &) = delete;
+        Random(Random &&) = delete;
+        //
+        Random & operator=(const Random &) = delete;
+        Random & operator=(Random &&) = delete;
+
+        // starts over as if just constructed with this seed
+        void reseed(const std::random_device::result_type seed)
         {
             std::seed_seq seedSequence{ seed };
             m_engine.seed(seedSequence);
@@ -32,13 +45,6 @@ namespace util
             m_engine.discard(123456);
         }
 
-        // prevent all copy and assignment
-        Random(const Random &) = delete;
-        Random(Random &&) = delete;
-        //
-        Random & operator=(const Random &) = delete;
-        Random & operator=(Random &&) = delete;
-
         template <typename T>
         T fromTo(const T from, const T to) const
         {
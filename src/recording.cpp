@@ -0,0 +1,271 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// recording.cpp
+//
+#include "recording.hpp"
+
+#include "check-macros.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace snake
+{
+    void Recording::captureConfig(const GameConfig & config)
+    {
+        resolution = config.resolution;
+        cell_size_window_ratio = config.cell_size_window_ratio;
+        status_bounds_height_ratio = config.status_bounds_height_ratio;
+        is_god_mode = config.is_god_mode;
+        will_ai_drive_player = config.will_ai_drive_player;
+        rival_snake_count = config.rival_snake_count;
+        sim_ticks_per_sec = config.sim_ticks_per_sec;
+        input_queue_depth = config.input_queue_depth;
+        score_per_life_bonus = config.score_per_life_bonus;
+        level_eat_count_base = config.level_eat_count_base;
+        level_turn_shrink_per_eat_base = config.level_turn_shrink_per_eat_base;
+        level_turn_shrink_per_eat_per_level = config.level_turn_shrink_per_eat_per_level;
+        obstacle_count_limit = config.obstacle_count_limit;
+    }
+
+    void Recording::applyConfigTo(GameConfig & config) const
+    {
+        config.random_seed = seed;
+        config.resolution = resolution;
+        config.cell_size_window_ratio = cell_size_window_ratio;
+        config.status_bounds_height_ratio = status_bounds_height_ratio;
+        config.is_god_mode = is_god_mode;
+        config.will_ai_drive_player = will_ai_drive_player;
+        config.rival_snake_count = rival_snake_count;
+        config.sim_ticks_per_sec = sim_ticks_per_sec;
+        config.input_queue_depth = input_queue_depth;
+        config.score_per_life_bonus = score_per_life_bonus;
+        config.level_eat_count_base = level_eat_count_base;
+        config.level_turn_shrink_per_eat_base = level_turn_shrink_per_eat_base;
+        config.level_turn_shrink_per_eat_per_level = level_turn_shrink_per_eat_per_level;
+        config.obstacle_count_limit = obstacle_count_limit;
+    }
+
+    void Recording::save(const std::filesystem::path & path) const
+    {
+        Bytes_t bytes;
+        bytes.reserve(64 + (inputs.size() * 4));
+
+        for (std::size_t byteIndex(0); byteIndex < sizeof(m_magic); ++byteIndex)
+        {
+            bytes.push_back(static_cast<std::uint8_t>(m_magic >> (byteIndex * 8)));
+        }
+
+        bytes.push_back(m_version);
+
+        writeVarint(bytes, seed);
+        writeVarint(bytes, resolution.x);
+        writeVarint(bytes, resolution.y);
+        writeFloat(bytes, cell_size_window_ratio);
+        writeFloat(bytes, status_bounds_height_ratio);
+        writeVarint(bytes, ((is_god_mode) ? 1 : 0));
+        writeVarint(bytes, ((will_ai_drive_player) ? 1 : 0));
+        writeVarint(bytes, rival_snake_count);
+        writeVarint(bytes, sim_ticks_per_sec);
+        writeVarint(bytes, input_queue_depth);
+        writeVarint(bytes, score_per_life_bonus);
+        writeVarint(bytes, level_eat_count_base);
+        writeFloat(bytes, level_turn_shrink_per_eat_base);
+        writeFloat(bytes, level_turn_shrink_per_eat_per_level);
+        writeVarint(bytes, obstacle_count_limit);
+
+        writeVarint(bytes, zigzag(final_score));
+        writeVarint(bytes, final_level);
+        writeVarint(bytes, final_tick_count);
+        writeVarint(bytes, ((is_game_over) ? 1 : 0));
+
+        writeVarint(bytes, inputs.size());
+
+        std::size_t pollTickPrev{ 0 };
+        for (const RecordedInput & input : inputs)
+        {
+            M_CHECK_SS((input.poll_tick >= pollTickPrev), "Recorded keys are out of order.");
+            M_CHECK_SS((input.input_tick >= input.poll_tick), "Key stamped before it was polled.");
+            M_CHECK_SS(((input.key >= 0) && (input.key <= 255)), input.key);
+
+            writeVarint(bytes, (input.poll_tick - pollTickPrev));
+            writeVarint(bytes, (input.input_tick - input.poll_tick));
+            bytes.push_back(static_cast<std::uint8_t>(input.key));
+
+            pollTickPrev = input.poll_tick;
+        }
+
+        std::ofstream fStream(path, (std::ios_base::binary | std::ios_base::trunc));
+
+        M_CHECK_SS(
+            (fStream.is_open() && fStream.good()),
+            "Failed to open recording file for writing: " << path);
+
+        fStream.write(
+            reinterpret_cast<const char *>(bytes.data()),
+            static_cast<std::streamsize>(bytes.size()));
+
+        M_CHECK_SS(fStream.good(), "Failed to write recording file: " << path);
+    }
+
+    Recording Recording::load(const std::filesystem::path & path)
+    {
+        std::ifstream fStream(path, std::ios_base::binary);
+
+        M_CHECK_SS(
+            (fStream.is_open() && fStream.good()),
+            "Failed to open recording file for reading: " << path);
+
+        const Bytes_t bytes{ std::istreambuf_iterator<char>(fStream),
+                             std::istreambuf_iterator<char>() };
+
+        M_CHECK_SS(
+            (bytes.size() > sizeof(m_magic)), "Recording file is too small to be one: " << path);
+
+        std::uint32_t magic{ 0 };
+        for (std::size_t byteIndex(0); byteIndex < sizeof(m_magic); ++byteIndex)
+        {
+            magic |= (static_cast<std::uint32_t>(bytes[byteIndex]) << (byteIndex * 8));
+        }
+
+        M_CHECK_SS((m_magic == magic), "Not a recording file: " << path);
+
+        std::size_t offset{ sizeof(m_magic) };
+        const std::uint8_t version{ bytes[offset++] };
+
+        M_CHECK_SS(
+            (m_version == version),
+            "Recording file " << path << " is version " << static_cast<int>(version)
+                              << " but only version " << static_cast<int>(m_version)
+                              << " can be played.");
+
+        Recording recording;
+        recording.seed = static_cast<Seed_t>(readVarint(bytes, offset));
+        recording.resolution.x = static_cast<unsigned int>(readVarint(bytes, offset));
+        recording.resolution.y = static_cast<unsigned int>(readVarint(bytes, offset));
+        recording.cell_size_window_ratio = readFloat(bytes, offset);
+        recording.status_bounds_height_ratio = readFloat(bytes, offset);
+        recording.is_god_mode = (readVarint(bytes, offset) != 0);
+        recording.will_ai_drive_player = (readVarint(bytes, offset) != 0);
+        recording.rival_snake_count = readVarint(bytes, offset);
+        recording.sim_ticks_per_sec = readVarint(bytes, offset);
+        recording.input_queue_depth = readVarint(bytes, offset);
+        recording.score_per_life_bonus = readVarint(bytes, offset);
+        recording.level_eat_count_base = readVarint(bytes, offset);
+        recording.level_turn_shrink_per_eat_base = readFloat(bytes, offset);
+        recording.level_turn_shrink_per_eat_per_level = readFloat(bytes, offset);
+        recording.obstacle_count_limit = readVarint(bytes, offset);
+
+        recording.final_score = unZigzag(readVarint(bytes, offset));
+        recording.final_level = readVarint(bytes, offset);
+        recording.final_tick_count = readVarint(bytes, offset);
+        recording.is_game_over = (readVarint(bytes, offset) != 0);
+
+        const std::uint64_t inputCount{ readVarint(bytes, offset) };
+
+        // every key takes at least three bytes, so a bad count can't allocate too much
+        M_CHECK_SS(
+            (inputCount <= (bytes.size() - offset)),
+            "Recording file " << path << " says it has " << inputCount << " keys.");
+
+        recording.inputs.reserve(inputCount);
+
+        std::size_t pollTick{ 0 };
+        for (std::uint64_t inputIndex(0); inputIndex < inputCount; ++inputIndex)
+        {
+            RecordedInput input;
+            pollTick += readVarint(bytes, offset);
+            input.poll_tick = pollTick;
+            input.input_tick = (pollTick + readVarint(bytes, offset));
+
+            M_CHECK_SS((offset < bytes.size()), "Recording file ended early: " << path);
+            input.key = static_cast<sf::Keyboard::Key>(bytes[offset++]);
+
+            recording.inputs.push_back(input);
+        }
+
+        M_CHECK_SS(
+            (offset == bytes.size()),
+            "Recording file " << path << " has " << (bytes.size() - offset)
+                              << " bytes left over after the last key.");
+
+        return recording;
+    }
+
+    void Recording::writeVarint(Bytes_t & bytes, const std::uint64_t number)
+    {
+        // seven bits at a time starting with the lowest, and the high bit says more follow
+        std::uint64_t remaining{ number };
+        while (remaining >= 0x80)
+        {
+            bytes.push_back(static_cast<std::uint8_t>((remaining & 0x7F) | 0x80));
+            remaining >>= 7;
+        }
+
+        bytes.push_back(static_cast<std::uint8_t>(remaining));
+    }
+
+    void Recording::writeFloat(Bytes_t & bytes, const float number)
+    {
+        static_assert(sizeof(float) == sizeof(std::uint32_t));
+
+        std::uint32_t bits{ 0 };
+        std::memcpy(&bits, &number, sizeof(bits));
+
+        for (std::size_t byteIndex(0); byteIndex < sizeof(bits); ++byteIndex)
+        {
+            bytes.push_back(static_cast<std::uint8_t>(bits >> (byteIndex * 8)));
+        }
+    }
+
+    std::uint64_t Recording::readVarint(const Bytes_t & bytes, std::size_t & offset)
+    {
+        std::uint64_t number{ 0 };
+        for (unsigned int shift(0); shift < 64; shift += 7)
+        {
+            M_CHECK_SS((offset < bytes.size()), "Recording file ended in the middle of a number.");
+
+            const std::uint8_t byte{ bytes[offset++] };
+            number |= (static_cast<std::uint64_t>(byte & 0x7F) << shift);
+
+            if ((byte & 0x80) == 0)
+            {
+                return number;
+            }
+        }
+
+        M_CHECK_SS(false, "Recording file has a number too big to be one.");
+        return number;
+    }
+
+    float Recording::readFloat(const Bytes_t & bytes, std::size_t & offset)
+    {
+        M_CHECK_SS(
+            ((offset + sizeof(std::uint32_t)) <= bytes.size()),
+            "Recording file ended in the middle of a number.");
+
+        std::uint32_t bits{ 0 };
+        for (std::size_t byteIndex(0); byteIndex < sizeof(bits); ++byteIndex)
+        {
+            bits |= (static_cast<std::uint32_t>(bytes[offset++]) << (byteIndex * 8));
+        }
+
+        float number{ 0.0f };
+        std::memcpy(&number, &bits, sizeof(number));
+        return number;
+    }
+
+    std::uint64_t Recording::zigzag(const int number)
+    {
+        const std::int64_t wide{ number };
+        return ((static_cast<std::uint64_t>(wide) << 1) ^ static_cast<std::uint64_t>(wide >> 63));
+    }
+
+    int Recording::unZigzag(const std::uint64_t number)
+    {
+        return static_cast<int>(
+            static_cast<std::int64_t>(number >> 1) ^ -static_cast<std::int64_t>(number & 1));
+    }
+} // namespace snake
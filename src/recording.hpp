@@ -0,0 +1,93 @@
+#ifndef SNAKE_RECORDING_HPP_INCLUDED
+#define SNAKE_RECORDING_HPP_INCLUDED
+//
+// recording.hpp
+//
+#include "settings.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <SFML/Window/Keyboard.hpp>
+
+namespace snake
+{
+    // A key that reached the Play state, the tick it was polled during (Context::sim_tick_count)
+    // and the tick it was stamped with (Context::input_tick), which can be later.
+    struct RecordedInput
+    {
+        std::size_t poll_tick{ 0 };
+        std::size_t input_tick{ 0 };
+        sf::Keyboard::Key key{ sf::Keyboard::Unknown };
+    };
+
+    //
+
+    // Everything needed to play a game again exactly the way it was played, see
+    // GameCoordinator::recordTo() and GameCoordinator::replay().  The game only changes one
+    // fixed tick at a time and only util::Random picks anything, so the seed, the GameConfig
+    // values the rules read, and every key with the ticks it arrived on are enough to put every
+    // piece in the same place, including every findFreeBoardPosRandom() spawn.  How the game
+    // ended is saved too, so a replay can tell if it really played out the same.
+    //
+    // Saved as a small binary file, with every whole number after the header packed as a varint
+    // and every poll tick saved as how many ticks after the one before it, so most keys take
+    // three or four bytes.
+    class Recording
+    {
+      public:
+        // keeps only the values that change how the game plays
+        void captureConfig(const GameConfig & config);
+        void applyConfigTo(GameConfig & config) const;
+
+        void save(const std::filesystem::path & path) const;
+        static Recording load(const std::filesystem::path & path);
+
+        Seed_t seed{ 0 };
+
+        sf::Vector2u resolution{ 0u, 0u };
+        float cell_size_window_ratio{ 0.0f };
+        float status_bounds_height_ratio{ 0.0f };
+        bool is_god_mode{ false };
+        bool will_ai_drive_player{ false };
+        std::size_t rival_snake_count{ 0 };
+        std::size_t sim_ticks_per_sec{ 0 };
+        std::size_t input_queue_depth{ 0 };
+        std::size_t score_per_life_bonus{ 0 };
+        std::size_t level_eat_count_base{ 0 };
+        float level_turn_shrink_per_eat_base{ 0.0f };
+        float level_turn_shrink_per_eat_per_level{ 0.0f };
+        std::size_t obstacle_count_limit{ 0 };
+
+        std::vector<RecordedInput> inputs;
+
+        int final_score{ 0 };
+        std::size_t final_level{ 0 };
+        std::size_t final_tick_count{ 0 };
+
+        // false if the game was stopped before it was over, such as by closing the window
+        bool is_game_over{ false };
+
+      private:
+        using Bytes_t = std::vector<std::uint8_t>;
+
+        static void writeVarint(Bytes_t & bytes, const std::uint64_t number);
+        static void writeFloat(Bytes_t & bytes, const float number);
+
+        // both fail an M_CHECK if the file ends first
+        static std::uint64_t readVarint(const Bytes_t & bytes, std::size_t & offset);
+        static float readFloat(const Bytes_t & bytes, std::size_t & offset);
+
+        // scores can be negative, so they are zigzag encoded to stay small either way
+        static std::uint64_t zigzag(const int number);
+        static int unZigzag(const std::uint64_t number);
+
+      private:
+        static inline const std::uint32_t m_magic{ 0x524B4E53 }; // "SNKR" little-endian
+        static inline const std::uint8_t m_version{ 1 };
+    };
+} // namespace snake
+
+#endif // SNAKE_RECORDING_HPP_INCLUDED
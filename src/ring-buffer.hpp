@@ -0,0 +1,186 @@
+#ifndef RING_BUFFER_HPP_INCLUDED
+#define RING_BUFFER_HPP_INCLUDED
+//
+// ring-buffer.hpp
+//
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace util
+{
+    // A contiguous double-ended queue with O(1) push_front()/pop_back() and O(1) truncate().
+    // Index zero is always the front.  T does not need to be default constructible, but it
+    // does need to be copyable because unused capacity is filled with copies of a real value.
+    template <typename T>
+    class RingBuffer
+    {
+      public:
+        template <bool IsConst_v>
+        class Iterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<IsConst_v, const T *, T *>;
+            using reference = std::conditional_t<IsConst_v, const T &, T &>;
+            using Ring_t = std::conditional_t<IsConst_v, const RingBuffer, RingBuffer>;
+
+            Iterator(Ring_t & ring, const std::size_t index)
+                : m_ring(&ring)
+                , m_index(index)
+            {}
+
+            reference operator*() const { return (*m_ring)[m_index]; }
+            pointer operator->() const { return &(*m_ring)[m_index]; }
+
+            Iterator & operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator before(*this);
+                ++m_index;
+                return before;
+            }
+
+            bool operator==(const Iterator & other) const
+            {
+                return ((m_ring == other.m_ring) && (m_index == other.m_index));
+            }
+
+            bool operator!=(const Iterator & other) const { return !(*this == other); }
+
+          private:
+            Ring_t * m_ring;
+            std::size_t m_index;
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        RingBuffer() = default;
+
+        bool empty() const { return (0 == m_size); }
+        std::size_t size() const { return m_size; }
+        std::size_t capacity() const { return m_items.size(); }
+
+        void clear()
+        {
+            m_first = 0;
+            m_size = 0;
+        }
+
+        T & operator[](const std::size_t index) { return m_items[slot(index)]; }
+        const T & operator[](const std::size_t index) const { return m_items[slot(index)]; }
+
+        T & front() { return m_items[slot(0)]; }
+        const T & front() const { return m_items[slot(0)]; }
+
+        T & back() { return m_items[slot(m_size - 1)]; }
+        const T & back() const { return m_items[slot(m_size - 1)]; }
+
+        iterator begin() { return iterator(*this, 0); }
+        iterator end() { return iterator(*this, m_size); }
+        const_iterator begin() const { return const_iterator(*this, 0); }
+        const_iterator end() const { return const_iterator(*this, m_size); }
+
+        void push_front(const T & value)
+        {
+            if (m_size == m_items.size())
+            {
+                grow(value);
+            }
+
+            m_first = ((m_first + m_items.size() - 1) & mask());
+            m_items[m_first] = value;
+            ++m_size;
+        }
+
+        void push_back(const T & value)
+        {
+            if (m_size == m_items.size())
+            {
+                grow(value);
+            }
+
+            m_items[slot(m_size)] = value;
+            ++m_size;
+        }
+
+        void pop_front()
+        {
+            throwIfEmpty("pop_front");
+            m_first = ((m_first + 1) & mask());
+            --m_size;
+        }
+
+        void pop_back()
+        {
+            throwIfEmpty("pop_back");
+            --m_size;
+        }
+
+        // removes everything after the first newSize elements, does nothing if already smaller
+        void truncate(const std::size_t newSize) { m_size = std::min(m_size, newSize); }
+
+        // O(n) because everything behind the erased element has to shift forward
+        void erase(const std::size_t index)
+        {
+            if (index >= m_size)
+            {
+                return;
+            }
+
+            for (std::size_t i(index + 1); i < m_size; ++i)
+            {
+                (*this)[i - 1] = (*this)[i];
+            }
+
+            --m_size;
+        }
+
+      private:
+        // capacity is always zero or a power of two so wrapping around is a bitwise and
+        std::size_t mask() const { return (m_items.size() - 1); }
+        std::size_t slot(const std::size_t index) const { return ((m_first + index) & mask()); }
+
+        void grow(const T & fillValue)
+        {
+            // unroll so that the front is at slot zero, then only the back end needs to grow
+            std::rotate(
+                std::begin(m_items),
+                (std::begin(m_items) + static_cast<std::ptrdiff_t>(m_first)),
+                std::end(m_items));
+
+            m_first = 0;
+
+            const std::size_t newCapacity{ std::max(m_minCapacity, (m_items.size() * 2)) };
+            m_items.resize(newCapacity, fillValue);
+        }
+
+        void throwIfEmpty(const std::string & funcName) const
+        {
+            if (empty())
+            {
+                throw std::runtime_error("RingBuffer::" + funcName + "() called when empty!");
+            }
+        }
+
+      private:
+        std::vector<T> m_items;
+        std::size_t m_first{ 0 };
+        std::size_t m_size{ 0 };
+
+        static inline const std::size_t m_minCapacity{ 16 };
+    };
+} // namespace util
+
+#endif // RING_BUFFER_HPP_INCLUDED
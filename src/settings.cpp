@@ -6,18 +6,17 @@
 #include "settings.hpp"
 
 #include "board.hpp"
-#include "cell-animations.hpp"
 #include "check-macros.hpp"
 #include "context.hpp"
+#include "game-observer.hpp"
 #include "layout.hpp"
 #include "pieces.hpp"
 #include "random.hpp"
-#include "sound-player.hpp"
-#include "states.hpp"
-#include "status-region.hpp"
+#include "states-pending.hpp"
 #include "util.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <sstream>
 
 namespace snake
@@ -35,6 +34,14 @@ namespace snake
         ss << "\n  initial_volume          = " << initial_volume;
         ss << "\n  cell_size_window_ratio  = " << cell_size_window_ratio;
         ss << "\n  stat_reg_height_ratio   = " << status_bounds_height_ratio;
+        ss << "\n  level_eat_count_base    = " << level_eat_count_base;
+        ss << "\n  turn_shrink_per_eat     = " << level_turn_shrink_per_eat_base << " - ("
+           << level_turn_shrink_per_eat_per_level << " * level)";
+        ss << "\n  obstacle_count_limit    = " << obstacle_count_limit;
+        ss << "\n  rival_snake_count       = " << rival_snake_count;
+        ss << "\n  will_ai_drive_player    = " << will_ai_drive_player;
+        ss << "\n  sim_ticks_per_sec       = " << sim_ticks_per_sec;
+        ss << "\n  is_headless             = " << is_headless;
         ss << "\n  is_fullscreen           = "
            << ((sf_window_style & sf::Style::Fullscreen) ? "true"
                                                          : std::to_string(sf_window_style));
@@ -42,6 +49,12 @@ namespace snake
         return ss.str();
     }
 
+    std::size_t GameConfig::secToTicks(const float seconds) const
+    {
+        const float ticks{ std::round(seconds * static_cast<float>(sim_ticks_per_sec)) };
+        return ((ticks < 1.0f) ? 1_st : static_cast<std::size_t>(ticks));
+    }
+
     //
 
     float Level::completedRatio() const
@@ -96,14 +109,16 @@ namespace snake
         const std::size_t levelSqrtST{ static_cast<std::size_t>(std::sqrt(levelNumberST)) };
 
         eat_count_current = 0;
-        eat_count_required = (8 + levelSqrtST);
+        eat_count_required = (context.config.level_eat_count_base + levelSqrtST);
 
         tail_start_length = (10 + number);
         tail_grow_after_eat = ((tail_start_length / 2) + number);
 
         sec_per_turn_slowest = (6.0f / static_cast<float>(context.layout.cell_counts.y));
         sec_per_turn_current = sec_per_turn_slowest;
-        sec_per_turn_shrink_per_eat = (0.925f - (0.0025f * static_cast<float>(number)));
+        sec_per_turn_shrink_per_eat =
+            (context.config.level_turn_shrink_per_eat_base -
+             (context.config.level_turn_shrink_per_eat_per_level * static_cast<float>(number)));
 
         if (survived)
         {
@@ -173,8 +188,10 @@ namespace snake
 
     BoardPosVec_t Level::makeFoodPositions(const Context & context) const
     {
-        const std::size_t count =
-            context.random.fromTo(0_st, (context.game.level().remainingToEat() - 4));
+        // level_eat_count_base can be small enough that fewer than four remain
+        const std::size_t remainingToEat{ context.game.level().remainingToEat() };
+        const std::size_t countMax{ (remainingToEat > 4) ? (remainingToEat - 4) : 0 };
+        const std::size_t count{ context.random.fromTo(0_st, countMax) };
 
         BoardPosVec_t positions;
         positions.reserve(count);
@@ -198,21 +215,78 @@ namespace snake
         m_level.setup(context, 1, true);
 
         m_score = 0;
-        m_eatSfxPitch = context.config.eat_sfx_pitch_start;
         m_lives = 3;
         m_isGameOver = false;
 
         context.board.loadMap(context, true);
+        context.observer.onLevelStarted(m_level.number);
     }
 
     void GameInPlay::setupNextLevel(Context & context, const bool survived)
     {
-        m_eatSfxPitch = context.config.eat_sfx_pitch_start;
-
         const std::size_t nextLevelNumber{ ((survived) ? (level().number + 1) : level().number) };
         m_level.setup(context, nextLevelNumber, survived);
 
         context.board.loadMap(context, survived);
+        context.observer.onLevelStarted(m_level.number);
+    }
+
+    void GameInPlay::tick(Context & context)
+    {
+        context.board.tick(context);
+
+        if ((++context.sim_tick_count % context.config.sim_ticks_per_sec) == 0)
+        {
+            placePeriodicPieces(context);
+        }
+    }
+
+    std::size_t GameInPlay::skipIdleTicks(Context & context, const std::size_t tickCountMax)
+    {
+        const std::size_t ticksPerSec{ context.config.sim_ticks_per_sec };
+        const std::size_t ticksUntilPlace{ ticksPerSec - (context.sim_tick_count % ticksPerSec) };
+        const std::size_t ticksUntilTurn{ context.board.ticksUntilNextTurn() };
+
+        std::size_t ticksUntilBusy{ ticksUntilPlace };
+        if ((ticksUntilTurn > 0) && (ticksUntilTurn < ticksUntilBusy))
+        {
+            ticksUntilBusy = ticksUntilTurn;
+        }
+
+        const std::size_t skipCount{ std::min((ticksUntilBusy - 1), tickCountMax) };
+
+        context.board.skipTicks(skipCount);
+        context.sim_tick_count += skipCount;
+        return skipCount;
+    }
+
+    void GameInPlay::placePeriodicPieces(Context & context)
+    {
+        // Periodically place new food at random place on the map, because there
+        // are just too many ways for food to either be destroyed or unreachable.
+        // Also take this opportunity to place rare helper pieces like slow/shrink.
+        if (m_isGameOver || m_level.isComplete())
+        {
+            return;
+        }
+
+        if ((m_level.remainingToEat() > 0) && (context.board.countPieces(Piece::Food) == 0))
+        {
+            context.board.addNewPieceAtRandomFreePos(context, Piece::Food);
+
+            if (m_level.remainingToEat() <= 4)
+            {
+                if (context.random.boolean() && (context.board.countPieces(Piece::Slow) == 0))
+                {
+                    context.board.addNewPieceAtRandomFreePos(context, Piece::Slow);
+                }
+
+                if (context.random.boolean() && (context.board.countPieces(Piece::Shrink) == 0))
+                {
+                    context.board.addNewPieceAtRandomFreePos(context, Piece::Shrink);
+                }
+            }
+        }
     }
 
     std::string GameInPlay::toString() const
@@ -263,16 +337,11 @@ namespace snake
             handlePickupLethal(context, pos, piece);
         }
 
-        context.status.updateText(context);
+        context.observer.onGameStatusChanged();
     }
 
-    void GameInPlay::handlePickupFood(Context & context, const BoardPos_t & pos, const Piece piece)
+    void GameInPlay::handlePickupFood(Context & context, const BoardPos_t & pos, const Piece)
     {
-        context.audio.play("shine", m_eatSfxPitch);
-        m_eatSfxPitch += context.config.eat_sfx_pitch_adj;
-
-        context.cell_anims.addGrowFadeAnim(context.layout.cellBounds(pos), piece::toColor(piece));
-
         m_level.handlePickupFood(context);
 
         int scoreEarned = calcScoreForEating(context);
@@ -291,79 +360,56 @@ namespace snake
         const int liveBonusesAfter =
             (m_score / static_cast<int>(context.config.score_per_life_bonus));
 
-        if (liveBonusesBefore == liveBonusesAfter)
-        {
-            context.cell_anims.addRisingText(
-                context,
-                "+" + std::to_string(scoreEarned),
-                context.config.grow_fade_text_color,
-                context.layout.cellBounds(pos));
-        }
-        else
+        const bool isLifeBonus{ liveBonusesBefore != liveBonusesAfter };
+        if (isLifeBonus)
         {
             ++m_lives;
-
-            context.cell_anims.addRisingText(
-                context,
-                "LIFE BONUS!",
-                context.config.grow_fade_text_color,
-                context.layout.cellBounds(pos));
         }
+
+        context.observer.onFoodEaten(pos, scoreEarned, isLifeBonus);
     }
 
-    void GameInPlay::handlePickupSlow(Context & context, const BoardPos_t & pos, const Piece piece)
+    void GameInPlay::handlePickupSlow(Context & context, const BoardPos_t & pos, const Piece)
     {
-        context.audio.play("slow", m_eatSfxPitch);
-
-        context.cell_anims.addGrowFadeAnim(context.layout.cellBounds(pos), piece::toColor(piece));
-
-        context.cell_anims.addRisingText(
-            context, "SLOW!", context.config.grow_fade_text_color, context.layout.cellBounds(pos));
-
+        context.observer.onSlowEaten(pos);
         m_level.handlePickupSlow(context);
     }
 
-    void
-        GameInPlay::handlePickupShrink(Context & context, const BoardPos_t & pos, const Piece piece)
+    void GameInPlay::handlePickupShrink(Context & context, const BoardPos_t & pos, const Piece)
     {
-        context.audio.play("explode-puff", m_eatSfxPitch);
-
-        context.cell_anims.addGrowFadeAnim(context.layout.cellBounds(pos), piece::toColor(piece));
-
-        context.cell_anims.addRisingText(
-            context,
-            "SHRINK!",
-            context.config.grow_fade_text_color,
-            context.layout.cellBounds(pos));
-
+        context.observer.onShrinkEaten(pos);
         context.board.shrinkTail(context);
     }
 
     void GameInPlay::handlePickupLethal(Context & context, const BoardPos_t &, const Piece piece)
     {
-        if (piece == Piece::Wall)
-        {
-            context.audio.play("mario-break-block");
-        }
-        else if ((piece == Piece::Tail) || (piece == Piece::Head))
+        M_CHECK_SS((m_lives > 0), "GameInPlay::m_lives was zero when it should not be!");
+
+        --m_lives;
+
+        // nobody is watching headless games, and the BatchSimulator plays many at once
+        if (!context.config.is_headless)
         {
-            context.audio.play("step-smash-yuck");
-        }
+            std::cout << "Player bit into " << piece << " and loses a life with " << m_lives
+                      << " remaining";
 
-        std::cout << "Player bit into " << piece << " and loses a life with ";
+            if (0 == m_lives)
+            {
+                std::cout << " and dies";
 
-        M_CHECK_SS((m_lives > 0), "GameInPlay::m_lives was zero when it should not be!");
+                if (context.config.is_god_mode)
+                {
+                    std::cout << "...but god mode saves you";
+                }
+            }
 
-        --m_lives;
-        std::cout << m_lives << " remaining";
+            std::cout << ".\n";
+        }
 
         if (0 == m_lives)
         {
-            std::cout << " and dies";
-
             if (context.config.is_god_mode)
             {
-                std::cout << "...but god mode saves you";
                 m_lives = 1;
             }
             else
@@ -372,8 +418,7 @@ namespace snake
             }
         }
 
-        std::cout << ".\n";
-
+        context.observer.onLifeLost(piece);
         context.state.setChangePending(State::Over);
     }
 
@@ -10,15 +10,18 @@
 
 #include <filesystem>
 #include <optional>
+#include <random>
 #include <string>
 #include <vector>
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/WindowStyle.hpp>
 
 //
 
 namespace snake
 {
+    using Seed_t = std::random_device::result_type;
 
     // Parameters that CANNOT change during play, but can be customized before play starts.
     class GameConfig
@@ -39,11 +42,6 @@ namespace snake
         unsigned int frame_rate_limit{ 60u }; // zero means there is no limit
         unsigned int sf_window_style{ static_cast<unsigned>(sf::Style::Fullscreen) };
 
-        sf::Color window_background_color{ sf::Color::Black };
-        sf::Color board_background_color{ sf::Color::Black };
-        sf::Color alt_board_background_color{ 27, 0, 13 };
-        sf::Color grow_fade_text_color{ 255, 255, 200 };
-
         float cell_size_window_ratio{ 0.015f };
         float status_bounds_height_ratio{ 0.02f };
 
@@ -58,7 +56,53 @@ namespace snake
 
         std::size_t score_per_life_bonus{ 10000 };
 
+        // How much harder each level is than the last, see Level::setup() and DifficultyTuner.
+        // Level N needs (level_eat_count_base + sqrt(N)) food eaten to complete it, and every
+        // food eaten multiplies the time per turn by (level_turn_shrink_per_eat_base -
+        // (level_turn_shrink_per_eat_per_level * N)).  Level N has N obstacles up to the limit.
+        std::size_t level_eat_count_base{ 8 };
+        float level_turn_shrink_per_eat_base{ 0.925f };
+        float level_turn_shrink_per_eat_per_level{ 0.0025f };
         std::size_t obstacle_count_limit{ 25 };
+
+        // snakes driven by the AI that share the board with the player, see HeadPiece
+        std::size_t rival_snake_count{ 0 };
+        bool will_ai_drive_player{ false };
+
+        // What the game's util::Random is seeded with, or something from std::random_device if
+        // empty.  The same seed, the same values here, and the same keys on the same ticks
+        // always play out the same game, see Recording.
+        std::optional<Seed_t> random_seed;
+
+        // only used when built with BOARD_VALIDATION, see Board::validate() and
+        // BoardView::validate(), which counts frames instead of ticks
+        std::size_t board_validate_tick_interval{ 60 };
+
+        // The game always advances in whole ticks of this length no matter what the frame rate
+        // is, see GameCoordinator::simulate().  After a long stall (dragging the window, a slow
+        // bloom frame) only sim_ticks_per_frame_max are caught up and the rest of that time is
+        // dropped, so the game pauses instead of jumping ahead.
+        std::size_t sim_ticks_per_sec{ 240 };
+        std::size_t sim_ticks_per_frame_max{ 24 };
+
+        // how many times faster than real time the ticks run, mostly for watching replays
+        float sim_speed{ 1.0f };
+
+        // how many turns ahead arrow keys can be pressed, see HeadPiece::handleEvent()
+        std::size_t input_queue_depth{ 2 };
+
+        // No window, sound, animations or media, and GameCoordinator::play() runs
+        // headless_game_count whole games one tick at a time as fast as it can.  Keys only come
+        // from GameCoordinator::inputScript(), so set will_ai_drive_player if there is none.
+        // Games still going after headless_tick_limit ticks (god mode) are stopped and counted
+        // as timed out.  The layout is made from resolution as if it were the window size.  See
+        // BatchSimulator for playing many games at once on every core.
+        bool is_headless{ false };
+        std::size_t headless_game_count{ 1 };
+        std::size_t headless_tick_limit{ 240 * 60 * 30 };
+
+        // rounded to the nearest tick but never less than one
+        std::size_t secToTicks(const float seconds) const;
     };
 
     // Parameters that change per level and define how hard it is to play the game.
@@ -111,6 +155,17 @@ namespace snake
 
         void start(Context & context);
 
+        // One fixed simulation tick of play:  every head due takes its turn, and once a second
+        // of ticks new pieces might be placed.  Counted in ticks so that the same input always
+        // places the same pieces at the same time.
+        void tick(Context & context);
+
+        // Skips every tick before the next one where a head takes its turn or pieces might be
+        // placed, but never more than tickCountMax, and returns how many were skipped.  Playing
+        // after is the same as calling tick() that many times, because all those ticks would
+        // have done is count down every head's turn clock.
+        std::size_t skipIdleTicks(Context & context, const std::size_t tickCountMax);
+
         void setupNextLevel(Context & context, const bool survived);
 
         bool isGameOver() const { return m_isGameOver; }
@@ -129,11 +184,11 @@ namespace snake
         void handlePickupLethal(Context & context, const BoardPos_t & pos, const Piece piece);
         int calcLevelCompleteScoreBonus() const;
         int scoreAdj(const Context & context, const int adj);
+        void placePeriodicPieces(Context & context);
 
       private:
         Level m_level;
         int m_score{ 0 };
-        float m_eatSfxPitch{ 1.0f };
         std::size_t m_lives{ 0 };
         bool m_isGameOver{ false };
     };
@@ -0,0 +1,169 @@
+#ifndef SLOT_MAP_HPP_INCLUDED
+#define SLOT_MAP_HPP_INCLUDED
+//
+// slot-map.hpp
+//
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace util
+{
+    // Generation-checked handle into a SlotMap.  A default constructed handle is never valid.
+    struct SlotHandle
+    {
+        std::uint32_t index{ std::numeric_limits<std::uint32_t>::max() };
+        std::uint32_t generation{ 0 };
+    };
+
+    inline bool operator==(const SlotHandle & left, const SlotHandle & right) noexcept
+    {
+        return ((left.index == right.index) && (left.generation == right.generation));
+    }
+
+    inline bool operator!=(const SlotHandle & left, const SlotHandle & right) noexcept
+    {
+        return !(left == right);
+    }
+
+    // Values are kept packed in a vector so iterating is as fast as a std::vector, while
+    // insert() and erase() by handle are both O(1).  Erasing moves the last value into the
+    // hole, so the order of iteration is not stable.  Any handle to an erased value (or to any
+    // value when clear() is called) stops being valid because its generation no longer matches.
+    template <typename T>
+    class SlotMap
+    {
+      public:
+        using iterator = typename std::vector<T>::iterator;
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+        SlotMap() = default;
+
+        bool empty() const { return m_values.empty(); }
+        std::size_t size() const { return m_values.size(); }
+
+        void reserve(const std::size_t count)
+        {
+            m_values.reserve(count);
+            m_valueSlots.reserve(count);
+            m_slots.reserve(count);
+        }
+
+        iterator begin() { return std::begin(m_values); }
+        iterator end() { return std::end(m_values); }
+        const_iterator begin() const { return std::begin(m_values); }
+        const_iterator end() const { return std::end(m_values); }
+
+        // the first in iteration order, which is NOT the first inserted
+        T & front() { return m_values.front(); }
+        const T & front() const { return m_values.front(); }
+
+        SlotHandle insert(const T & value)
+        {
+            std::uint32_t slotIndex{ 0 };
+
+            if (m_freeSlots.empty())
+            {
+                slotIndex = static_cast<std::uint32_t>(m_slots.size());
+                m_slots.push_back(Slot{});
+            }
+            else
+            {
+                slotIndex = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+
+            Slot & slot{ m_slots[slotIndex] };
+            slot.value_index = static_cast<std::uint32_t>(m_values.size());
+
+            m_values.push_back(value);
+            m_valueSlots.push_back(slotIndex);
+
+            return { slotIndex, slot.generation };
+        }
+
+        bool contains(const SlotHandle & handle) const
+        {
+            return (
+                (handle.index < m_slots.size()) &&
+                (m_slots[handle.index].generation == handle.generation) &&
+                (m_slots[handle.index].value_index < m_values.size()));
+        }
+
+        T * find(const SlotHandle & handle)
+        {
+            return ((contains(handle)) ? &m_values[m_slots[handle.index].value_index] : nullptr);
+        }
+
+        const T * find(const SlotHandle & handle) const
+        {
+            return ((contains(handle)) ? &m_values[m_slots[handle.index].value_index] : nullptr);
+        }
+
+        // returns false if the handle was stale or invalid
+        bool erase(const SlotHandle & handle)
+        {
+            if (!contains(handle))
+            {
+                return false;
+            }
+
+            Slot & slot{ m_slots[handle.index] };
+            const std::uint32_t holeIndex{ slot.value_index };
+            const std::uint32_t lastIndex{ static_cast<std::uint32_t>(m_values.size() - 1) };
+
+            if (holeIndex != lastIndex)
+            {
+                m_values[holeIndex] = m_values[lastIndex];
+                m_valueSlots[holeIndex] = m_valueSlots[lastIndex];
+                m_slots[m_valueSlots[holeIndex]].value_index = holeIndex;
+            }
+
+            m_values.pop_back();
+            m_valueSlots.pop_back();
+
+            retireSlot(handle.index);
+            return true;
+        }
+
+        // O(n) because every live slot has to be retired so that no handle stays valid
+        void clear()
+        {
+            for (const std::uint32_t slotIndex : m_valueSlots)
+            {
+                retireSlot(slotIndex);
+            }
+
+            m_values.clear();
+            m_valueSlots.clear();
+        }
+
+      private:
+        void retireSlot(const std::uint32_t slotIndex)
+        {
+            Slot & slot{ m_slots[slotIndex] };
+            slot.value_index = m_invalidIndex;
+            ++slot.generation;
+            m_freeSlots.push_back(slotIndex);
+        }
+
+        struct Slot
+        {
+            std::uint32_t value_index{ m_invalidIndex };
+            std::uint32_t generation{ 1 }; // starts at one so default handles never match
+        };
+
+      private:
+        std::vector<T> m_values;
+        std::vector<std::uint32_t> m_valueSlots; // parallel to m_values
+        std::vector<Slot> m_slots;
+        std::vector<std::uint32_t> m_freeSlots;
+
+        static inline const std::uint32_t m_invalidIndex{
+            std::numeric_limits<std::uint32_t>::max()
+        };
+    };
+} // namespace util
+
+#endif // SLOT_MAP_HPP_INCLUDED
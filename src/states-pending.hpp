@@ -0,0 +1,85 @@
+#ifndef SNAKE_STATES_PENDING_HPP_INCLUDED
+#define SNAKE_STATES_PENDING_HPP_INCLUDED
+//
+// states-pending.hpp
+//
+#include <optional>
+#include <ostream>
+#include <string>
+
+// The game rules only ever ask for a state change (a life lost, a level complete) and never
+// run a State themselves, so this is all of the states that the rules need to know about, and
+// the StateMachine that runs them is part of the front-end, see states.hpp.
+
+namespace snake
+{
+    enum class State
+    {
+        Start = 0, // an empty "do-nothing" placeholder while the app starts up
+        Option,    // first thing player sees, allows customizing game before it starts
+        Play,
+        Pause,
+        LevelCompleteMsg, // TimedMessage showing "Level Survived!"
+        NextLevelMsg,     // TimedMessage showing what level # is next
+        Over,             // game over, play death music, let player see what happened
+        Quit              // performs all normal shutdown and exits the program
+    };
+
+    using StateOpt_t = std::optional<State>;
+
+    //
+
+    namespace state
+    {
+        inline std::string toString(const State state)
+        {
+            switch (state)
+            {
+                case State::Start: return "Start";
+                case State::Option: return "Option";
+                case State::Play: return "Play";
+                case State::Pause: return "Pause";
+                case State::LevelCompleteMsg: return "LevelCompleteMsg";
+                case State::NextLevelMsg: return "NextLevelMsg";
+                case State::Over: return "Over";
+                case State::Quit: return "Quit";
+                default: return "";
+            }
+        }
+    } // namespace state
+
+    //
+    inline std::ostream & operator<<(std::ostream & os, const State state)
+    {
+        os << state::toString(state);
+        return os;
+    }
+
+    //
+    struct IStatesPending
+    {
+        virtual ~IStatesPending() = default;
+
+        virtual bool isChangePending() const = 0;
+        virtual StateOpt_t getChangePending() const = 0;
+        virtual void setChangePending(const State state) = 0;
+    };
+
+    // only remembers the last change asked for, for running the rules without a StateMachine
+    class StatesPending final : public IStatesPending
+    {
+      public:
+        StatesPending() = default;
+
+        void reset() { m_changePendingOpt.reset(); }
+
+        bool isChangePending() const override { return m_changePendingOpt.has_value(); }
+        StateOpt_t getChangePending() const override { return m_changePendingOpt; }
+        void setChangePending(const State state) override { m_changePendingOpt = state; }
+
+      private:
+        StateOpt_t m_changePendingOpt;
+    };
+} // namespace snake
+
+#endif // SNAKE_STATES_PENDING_HPP_INCLUDED
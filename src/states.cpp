@@ -6,17 +6,18 @@
 #include "states.hpp"
 
 #include "animation-player.hpp"
+#include "board-view.hpp"
 #include "board.hpp"
 #include "cell-animations.hpp"
-#include "layout.hpp"
+#include "graphics-util.hpp"
 #include "media.hpp"
 #include "pieces.hpp"
+#include "pixel-layout.hpp"
 #include "random.hpp"
 #include "score-file.hpp"
 #include "settings.hpp"
 #include "sound-player.hpp"
 #include "status-region.hpp"
-#include "util.hpp"
 
 #include <sstream>
 
@@ -30,7 +31,7 @@ namespace snake
     {}
 
     StateBase::StateBase(
-        const Context & context,
+        const FrontEndContext & context,
         const State state,
         const State nextState,
         const std::string & message,
@@ -40,7 +41,7 @@ namespace snake
         setupText(context, message);
     }
 
-    void StateBase::setupText(const Context & context, const std::string & message)
+    void StateBase::setupText(const FrontEndContext & context, const std::string & message)
     {
         m_text.setString(message);
         m_text.setCharacterSize(99);
@@ -48,16 +49,16 @@ namespace snake
         m_text.setFillColor(m_textColorDefault);
 
         util::fitAndCenterInside(
-            m_text, util::scaleRectInPlaceCopy(context.layout.window_bounds_f, 0.25f));
+            m_text, util::scaleRectInPlaceCopy(context.pixel_layout.window_bounds_f, 0.25f));
     }
 
-    void StateBase::update(Context & context, const float elapsedSec)
+    void StateBase::update(FrontEndContext & context, const float elapsedSec)
     {
         m_elapsedTimeSec += elapsedSec;
         context.cell_anims.update(context, elapsedSec);
     }
 
-    bool StateBase::changeToNextState(const Context & context)
+    bool StateBase::changeToNextState(const FrontEndContext & context)
     {
         if (state() == m_nextState)
         {
@@ -68,7 +69,7 @@ namespace snake
         return true;
     }
 
-    bool StateBase::willIgnoreEvent(const Context & context, const sf::Event & event) const
+    bool StateBase::willIgnoreEvent(const FrontEndContext & context, const sf::Event & event) const
     {
         // all events should be ignored after a state change is scheduled
         if (context.state.isChangePending())
@@ -90,7 +91,7 @@ namespace snake
         // clang-format on
     }
 
-    bool StateBase::handleQuitEvents(Context & context, const sf::Event & event)
+    bool StateBase::handleQuitEvents(FrontEndContext & context, const sf::Event & event)
     {
         if (sf::Event::Closed == event.type)
         {
@@ -139,7 +140,7 @@ namespace snake
         return false;
     }
 
-    bool StateBase::handleEvent(Context & context, const sf::Event & event)
+    bool StateBase::handleEvent(FrontEndContext & context, const sf::Event & event)
     {
         if (willIgnoreEvent(context, event))
         {
@@ -155,9 +156,11 @@ namespace snake
     }
 
     void StateBase::draw(
-        const Context & context, sf::RenderTarget & target, const sf::RenderStates & states) const
+        const FrontEndContext & context,
+        sf::RenderTarget & target,
+        const sf::RenderStates & states) const
     {
-        context.board.draw(context, target, states);
+        context.board_view.draw(context, target, states);
 
         target.draw(context.anim, states);
         target.draw(context.cell_anims, states);
@@ -167,7 +170,7 @@ namespace snake
 
     //
 
-    OptionsState::OptionsState(Context & context)
+    OptionsState::OptionsState(FrontEndContext & context)
         : StateBase(
               context,
               State::Option,
@@ -176,14 +179,14 @@ namespace snake
               m_defaultMinDurationSec)
     {}
 
-    void OptionsState::onEnter(Context &) {}
+    void OptionsState::onEnter(FrontEndContext &) {}
 
-    void OptionsState::update(Context & context, const float elapsedSec)
+    void OptionsState::update(FrontEndContext & context, const float elapsedSec)
     {
         StateBase::update(context, elapsedSec);
     }
 
-    bool OptionsState::handleEvent(Context & context, const sf::Event & event)
+    bool OptionsState::handleEvent(FrontEndContext & context, const sf::Event & event)
     {
         if (StateBase::handleEvent(context, event))
         {
@@ -208,7 +211,7 @@ namespace snake
     //
 
     TimedMessageState::TimedMessageState(
-        const Context & context,
+        const FrontEndContext & context,
         const State state,
         const State nextState,
         const std::string & message,
@@ -216,12 +219,12 @@ namespace snake
         : StateBase(context, state, nextState, message, minDurationSec)
     {
         const sf::FloatRect textBounds{ util::scaleRectInPlaceCopy(
-            context.layout.board_bounds_f, 0.9f) };
+            context.pixel_layout.board_bounds_f, 0.9f) };
 
         util::centerInside(m_text, textBounds);
     }
 
-    bool TimedMessageState::handleEvent(Context & context, const sf::Event & event)
+    bool TimedMessageState::handleEvent(FrontEndContext & context, const sf::Event & event)
     {
         if (StateBase::handleEvent(context, event))
         {
@@ -247,7 +250,7 @@ namespace snake
         return false;
     }
 
-    void TimedMessageState::update(Context & context, const float elapsedSec)
+    void TimedMessageState::update(FrontEndContext & context, const float elapsedSec)
     {
         StateBase::update(context, elapsedSec);
 
@@ -259,7 +262,7 @@ namespace snake
 
     //
 
-    LevelCompleteMessageState::LevelCompleteMessageState(const Context & context)
+    LevelCompleteMessageState::LevelCompleteMessageState(const FrontEndContext & context)
         : TimedMessageState(
               context,
               State::LevelCompleteMsg,
@@ -268,12 +271,12 @@ namespace snake
               (m_defaultMinDurationSec * 2.0f))
     {}
 
-    void LevelCompleteMessageState::onEnter(Context &)
+    void LevelCompleteMessageState::onEnter(FrontEndContext &)
     {
         // std::cout << context.game.statusString("Level Complete") << std::endl;
     }
 
-    void LevelCompleteMessageState::onExit(Context & context)
+    void LevelCompleteMessageState::onExit(FrontEndContext & context)
     {
         context.cell_anims.reset();
         context.game.setupNextLevel(context, true);
@@ -281,7 +284,7 @@ namespace snake
 
     //
 
-    NextLevelMessageState::NextLevelMessageState(const Context & context)
+    NextLevelMessageState::NextLevelMessageState(const FrontEndContext & context)
         : TimedMessageState(
               context,
               State::NextLevelMsg,
@@ -290,34 +293,40 @@ namespace snake
               m_defaultMinDurationSec)
     {}
 
-    void NextLevelMessageState::onEnter(Context & context) { context.audio.play("level-intro"); }
+    void NextLevelMessageState::onEnter(FrontEndContext & context)
+    {
+        context.audio.play("level-intro");
+    }
 
-    std::string NextLevelMessageState::makeMessage(const Context & context)
+    std::string NextLevelMessageState::makeMessage(const FrontEndContext & context)
     {
         return ("Level #" + std::to_string(context.game.level().number));
     }
 
     //
 
-    GameOverState::GameOverState(const Context & context)
+    GameOverState::GameOverState(const FrontEndContext & context)
         : TimedMessageState(
               context, State::Over, State::NextLevelMsg, "You Died\nTry Again!\n\n", 4.5f)
     {}
 
-    void GameOverState::onEnter(Context & context) { context.audio.play("rpg-game-over"); }
+    void GameOverState::onEnter(FrontEndContext & context) { context.audio.play("rpg-game-over"); }
 
-    void GameOverState::onExit(Context & context)
+    void GameOverState::onExit(FrontEndContext & context)
     {
         if (context.game.lives() == 0)
         {
-            // save high score if needed
-            const int currentHighScore = context.score_file.readHighScore();
-            if (context.game.score() > currentHighScore)
+            // save high score if needed, but not for games played with nobody watching
+            if (!context.config.is_headless)
             {
-                std::cout << "You beat the high score of " << currentHighScore << " by "
-                          << (context.game.score() - currentHighScore) << "!\n";
-
-                context.score_file.writeHighScore(context.game.score());
+                const int currentHighScore = context.score_file.readHighScore();
+                if (context.game.score() > currentHighScore)
+                {
+                    std::cout << "You beat the high score of " << currentHighScore << " by "
+                              << (context.game.score() - currentHighScore) << "!\n";
+
+                    context.score_file.writeHighScore(context.game.score());
+                }
             }
 
             context.state.setChangePending(State::Quit);
@@ -328,13 +337,13 @@ namespace snake
         }
     }
 
-    PauseState::PauseState(const Context & context)
+    PauseState::PauseState(const FrontEndContext & context)
         : TimedMessageState(context, State::Pause, State::Play, "PAUSE", -1.0f)
     {}
 
-    void PauseState::onEnter(Context & context) { context.audio.play("mario-pause"); }
+    void PauseState::onEnter(FrontEndContext & context) { context.audio.play("mario-pause"); }
 
-    void PauseState::update(Context & context, const float elapsedSec)
+    void PauseState::update(FrontEndContext & context, const float elapsedSec)
     {
         // don't call StateBase's or TimedMessageState's update(),
         // because that will keep the animations running
@@ -348,22 +357,24 @@ namespace snake
 
     //
 
-    PlayState::PlayState(const Context & context)
+    PlayState::PlayState(const FrontEndContext & context)
         : StateBase(context, State::Play, State::Play)
     {}
 
-    void PlayState::onEnter(Context &)
+    void PlayState::onEnter(FrontEndContext &)
     {
         // std::cout << context.game.statusString("Play Starting") << std::endl;
     }
 
-    void PlayState::update(Context & context, const float elapsedSec)
+    void PlayState::update(FrontEndContext & context, const float elapsedSec)
     {
         StateBase::update(context, elapsedSec);
-        context.board.update(context, elapsedSec);
+        context.board_view.interpolateHeads(context);
     }
 
-    bool PlayState::handleEvent(Context & context, const sf::Event & event)
+    void PlayState::tick(FrontEndContext & context) { context.game.tick(context); }
+
+    bool PlayState::handleEvent(FrontEndContext & context, const sf::Event & event)
     {
         if (StateBase::handleEvent(context, event))
         {
@@ -399,7 +410,7 @@ namespace snake
 
     void StateMachine::setChangePending(const State state) { m_changePendingOpt = state; }
 
-    void StateMachine::changeIfPending(Context & context)
+    void StateMachine::changeIfPending(FrontEndContext & context)
     {
         if (!m_changePendingOpt)
         {
@@ -414,7 +425,7 @@ namespace snake
         m_stateUPtr->onEnter(context);
     }
 
-    IStateUPtr_t StateMachine::makeState(Context & context, const State state)
+    IStateUPtr_t StateMachine::makeState(FrontEndContext & context, const State state)
     {
         // clang-format off
         switch (state)
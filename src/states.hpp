@@ -6,6 +6,7 @@
 #include "check-macros.hpp"
 #include "context.hpp"
 #include "keys.hpp"
+#include "states-pending.hpp"
 
 #include <array>
 #include <memory>
@@ -25,54 +26,10 @@ namespace sf
 
 namespace snake
 {
-    struct Context;
+    struct FrontEndContext;
     class GameConfig;
     class Media;
 
-    //
-
-    enum class State
-    {
-        Start = 0, // an empty "do-nothing" placeholder while the app starts up
-        Option,    // first thing player sees, allows customizing game before it starts
-        Play,
-        Pause,
-        LevelCompleteMsg, // TimedMessage showing "Level Survived!"
-        NextLevelMsg,     // TimedMessage showing what level # is next
-        Over,             // game over, play death music, let player see what happened
-        Quit              // performs all normal shutdown and exits the program
-    };
-
-    using StateOpt_t = std::optional<State>;
-
-    //
-
-    namespace state
-    {
-        inline std::string toString(const State state)
-        {
-            switch (state)
-            {
-                case State::Start: return "Start";
-                case State::Option: return "Option";
-                case State::Play: return "Play";
-                case State::Pause: return "Pause";
-                case State::LevelCompleteMsg: return "LevelCompleteMsg";
-                case State::NextLevelMsg: return "NextLevelMsg";
-                case State::Over: return "Over";
-                case State::Quit: return "Quit";
-                default: return "";
-            }
-        }
-    } // namespace state
-
-    //
-    inline std::ostream & operator<<(std::ostream & os, const State state)
-    {
-        os << state::toString(state);
-        return os;
-    }
-
     //
     struct IState
     {
@@ -80,18 +37,23 @@ namespace snake
 
         virtual State state() const = 0;
         virtual State nextState() const = 0;
-        virtual void update(Context &, const float elapsedSec) = 0;
-        virtual bool handleEvent(Context & context, const sf::Event & event) = 0;
-        virtual void draw(const Context &, sf::RenderTarget &, const sf::RenderStates &) const = 0;
-        virtual void onEnter(Context &) = 0;
-        virtual void onExit(Context &) = 0;
+        virtual void update(FrontEndContext &, const float elapsedSec) = 0;
+
+        // one fixed simulation tick, see GameCoordinator::simulate(), update() is per frame
+        virtual void tick(FrontEndContext &) = 0;
+
+        virtual bool handleEvent(FrontEndContext & context, const sf::Event & event) = 0;
+        virtual void
+            draw(const FrontEndContext &, sf::RenderTarget &, const sf::RenderStates &) const = 0;
+        virtual void onEnter(FrontEndContext &) = 0;
+        virtual void onExit(FrontEndContext &) = 0;
 
       protected:
-        virtual bool changeToNextState(const Context &) = 0;
-        virtual bool willIgnoreEvent(const Context &, const sf::Event & event) const = 0;
+        virtual bool changeToNextState(const FrontEndContext &) = 0;
+        virtual bool willIgnoreEvent(const FrontEndContext &, const sf::Event & event) const = 0;
 
         // returns true if the event was a 'quit' event and a state changed is pneding
-        virtual bool handleQuitEvents(Context & context, const sf::Event & event) = 0;
+        virtual bool handleQuitEvents(FrontEndContext & context, const sf::Event & event) = 0;
     };
 
     using IStateUPtr_t = std::unique_ptr<IState>;
@@ -103,7 +65,7 @@ namespace snake
         StateBase(const State state, const State nextState, const float minDurationSec = -1.0f);
 
         StateBase(
-            const Context & context,
+            const FrontEndContext & context,
             const State state,
             const State nextState,
             const std::string & message = {},
@@ -121,11 +83,13 @@ namespace snake
 
         State state() const final { return m_state; }
         State nextState() const final { return m_nextState; }
-        void update(Context &, const float elapsedSec) override;
-        bool handleEvent(Context & context, const sf::Event & event) override;
-        void draw(const Context &, sf::RenderTarget &, const sf::RenderStates &) const override;
-        void onEnter(Context &) override {}
-        void onExit(Context &) override {}
+        void update(FrontEndContext &, const float elapsedSec) override;
+        void tick(FrontEndContext &) override {}
+        bool handleEvent(FrontEndContext & context, const sf::Event & event) override;
+        void draw(const FrontEndContext &, sf::RenderTarget &, const sf::RenderStates &)
+            const override;
+        void onEnter(FrontEndContext &) override {}
+        void onExit(FrontEndContext &) override {}
 
       protected:
         bool hasMinTimeElapsed() const
@@ -133,10 +97,10 @@ namespace snake
             return (!(m_minDurationSec > 0.0f) || (m_elapsedTimeSec > m_minDurationSec));
         }
 
-        bool changeToNextState(const Context &) override;
-        bool willIgnoreEvent(const Context &, const sf::Event & event) const override;
-        bool handleQuitEvents(Context &, const sf::Event &) override;
-        void setupText(const Context & context, const std::string & message);
+        bool changeToNextState(const FrontEndContext &) override;
+        bool willIgnoreEvent(const FrontEndContext &, const sf::Event & event) const override;
+        bool handleQuitEvents(FrontEndContext &, const sf::Event &) override;
+        void setupText(const FrontEndContext & context, const std::string & message);
         // void updateBgFade(const float elapsedSec);
 
       protected:
@@ -160,9 +124,11 @@ namespace snake
 
         virtual ~StartState() override = default;
 
-        void update(Context &, const float) final {}
-        bool handleEvent(Context &, const sf::Event &) final { return false; }
-        void draw(const Context &, sf::RenderTarget &, const sf::RenderStates &) const final {}
+        void update(FrontEndContext &, const float) final {}
+        bool handleEvent(FrontEndContext &, const sf::Event &) final { return false; }
+        void draw(const FrontEndContext &, sf::RenderTarget &, const sf::RenderStates &)
+            const final
+        {}
     };
 
     // the state that simply exits the application
@@ -174,27 +140,29 @@ namespace snake
 
         virtual ~QuitState() override = default;
 
-        void update(Context &, const float) final {}
-        bool handleEvent(Context &, const sf::Event &) final { return false; }
-        void draw(const Context &, sf::RenderTarget &, const sf::RenderStates &) const final {}
+        void update(FrontEndContext &, const float) final {}
+        bool handleEvent(FrontEndContext &, const sf::Event &) final { return false; }
+        void draw(const FrontEndContext &, sf::RenderTarget &, const sf::RenderStates &)
+            const final
+        {}
     };
 
     //
     struct OptionsState : public StateBase
     {
-        explicit OptionsState(Context & context);
+        explicit OptionsState(FrontEndContext & context);
         virtual ~OptionsState() override = default;
 
-        void update(Context &, const float elapsedSec) override;
-        bool handleEvent(Context & context, const sf::Event & event) override;
-        void onEnter(Context &) override;
+        void update(FrontEndContext &, const float elapsedSec) override;
+        bool handleEvent(FrontEndContext & context, const sf::Event & event) override;
+        void onEnter(FrontEndContext &) override;
     };
 
     //
     struct TimedMessageState : public StateBase
     {
         explicit TimedMessageState(
-            const Context & context,
+            const FrontEndContext & context,
             const State state,
             const State nextState,
             const std::string & message,
@@ -202,8 +170,8 @@ namespace snake
 
         virtual ~TimedMessageState() override = default;
 
-        void update(Context & context, const float elapsedSec) override;
-        bool handleEvent(Context & context, const sf::Event & event) override;
+        void update(FrontEndContext & context, const float elapsedSec) override;
+        bool handleEvent(FrontEndContext & context, const sf::Event & event) override;
 
       protected:
         bool m_hasMouseClickedOrKeyPressed{ false };
@@ -212,65 +180,56 @@ namespace snake
     //
     struct LevelCompleteMessageState : public TimedMessageState
     {
-        explicit LevelCompleteMessageState(const Context & context);
+        explicit LevelCompleteMessageState(const FrontEndContext & context);
         virtual ~LevelCompleteMessageState() override = default;
 
-        void onEnter(Context &) override;
-        void onExit(Context &) override;
+        void onEnter(FrontEndContext &) override;
+        void onExit(FrontEndContext &) override;
     };
 
     //
     struct NextLevelMessageState : public TimedMessageState
     {
-        explicit NextLevelMessageState(const Context & context);
+        explicit NextLevelMessageState(const FrontEndContext & context);
         virtual ~NextLevelMessageState() override = default;
 
-        void onEnter(Context &) override;
+        void onEnter(FrontEndContext &) override;
 
-        static std::string makeMessage(const Context & context);
+        static std::string makeMessage(const FrontEndContext & context);
     };
 
     //
     struct GameOverState : public TimedMessageState
     {
-        explicit GameOverState(const Context & context);
+        explicit GameOverState(const FrontEndContext & context);
         virtual ~GameOverState() override = default;
 
-        void onEnter(Context &) override;
-        void onExit(Context &) override;
+        void onEnter(FrontEndContext &) override;
+        void onExit(FrontEndContext &) override;
     };
 
     //
     struct PauseState : public TimedMessageState
     {
-        explicit PauseState(const Context & context);
+        explicit PauseState(const FrontEndContext & context);
         virtual ~PauseState() override = default;
 
-        void onEnter(Context &) override;
-        void update(Context & context, const float elapsedSec) override;
+        void onEnter(FrontEndContext &) override;
+        void update(FrontEndContext & context, const float elapsedSec) override;
     };
 
     //
     class PlayState : public StateBase
     {
       public:
-        explicit PlayState(const Context & context);
+        explicit PlayState(const FrontEndContext & context);
 
         virtual ~PlayState() override = default;
 
-        void onEnter(Context &) override;
-        bool handleEvent(Context &, const sf::Event &) override;
-        void update(Context & context, const float elapsedSec) override;
-    };
-
-    //
-    struct IStatesPending
-    {
-        virtual ~IStatesPending() = default;
-
-        virtual bool isChangePending() const = 0;
-        virtual StateOpt_t getChangePending() const = 0;
-        virtual void setChangePending(const State state) = 0;
+        void onEnter(FrontEndContext &) override;
+        bool handleEvent(FrontEndContext &, const sf::Event &) override;
+        void update(FrontEndContext & context, const float elapsedSec) override;
+        void tick(FrontEndContext & context) override;
     };
 
     //
@@ -297,10 +256,10 @@ namespace snake
         bool isChangePending() const override { return m_changePendingOpt.has_value(); }
         StateOpt_t getChangePending() const override { return m_changePendingOpt; }
         void setChangePending(const State state) override;
-        void changeIfPending(Context & context);
+        void changeIfPending(FrontEndContext & context);
 
       private:
-        IStateUPtr_t makeState(Context & context, const State state);
+        IStateUPtr_t makeState(FrontEndContext & context, const State state);
 
       private:
         IStateUPtr_t m_stateUPtr;
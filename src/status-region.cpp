@@ -5,14 +5,14 @@
 //
 #include "status-region.hpp"
 
-#include "layout.hpp"
 #include "media.hpp"
+#include "pixel-layout.hpp"
 #include "settings.hpp"
 
 namespace snake
 {
     StatusText::StatusText(
-        const Context & context,
+        const FrontEndContext & context,
         const std::string & prefix,
         const std::size_t digitCount,
         const sf::Color & color,
@@ -22,7 +22,7 @@ namespace snake
     }
 
     void StatusText::setup(
-        const Context & context,
+        const FrontEndContext & context,
         const std::string & prefix,
         const std::size_t digitCount,
         const sf::Color & color,
@@ -71,7 +71,7 @@ namespace snake
 
     //
 
-    void StatusRegion::reset(const Context & context)
+    void StatusRegion::reset(const FrontEndContext & context)
     {
         // a collection of text colors that look good in the status region
         // const sf::Color yellowOrange(255, 190, 0);
@@ -83,7 +83,7 @@ namespace snake
         m_texts.clear();
         m_texts.reserve(10);
 
-        m_statusBounds = context.layout.status_bounds_f;
+        m_statusBounds = context.pixel_layout.status_bounds_f;
         m_textBounds = util::scaleRectInPlaceCopy(m_statusBounds, { 0.95f, 0.65f });
 
         float textHeight{ m_textBounds.height };
@@ -118,7 +118,7 @@ namespace snake
                     statusText.height(textHeight);
                 }
 
-                const float posTop{ (context.layout.board_bounds_f.top -
+                const float posTop{ (context.pixel_layout.board_bounds_f.top -
                                      statusText.bounds().height) +
                                     (m_statusBounds.height / 23.0f) };
 
@@ -159,7 +159,7 @@ namespace snake
     }
 
     void StatusRegion::draw(
-        const Context & context, sf::RenderTarget & target, sf::RenderStates states) const
+        const FrontEndContext & context, sf::RenderTarget & target, sf::RenderStates states) const
     {
         for (const StatusText & statusText : m_texts)
         {
@@ -172,12 +172,16 @@ namespace snake
         }
     }
 
-    void StatusRegion::updateText(const Context & context)
+    void StatusRegion::updateText(const FrontEndContext & context)
     {
         m_texts.at(0).updateNumber(context.game.level().number);
         m_texts.at(1).updateNumber(context.game.score());
         m_texts.at(2).updateNumber(context.game.lives());
 
-        m_fps.setString("FPS=" + std::to_string(context.fps));
+        m_fps.setString(
+            "FPS=" + std::to_string(context.fps) +
+            "  VB=" + std::to_string(context.vertex_bytes_per_frame) +
+            "  KeysDropped=" + std::to_string(context.input_dropped_count) +
+            "  KeysCoalesced=" + std::to_string(context.input_coalesced_count));
     }
 } // namespace snake
@@ -5,8 +5,8 @@
 //
 #include "check-macros.hpp"
 #include "context.hpp"
+#include "graphics-util.hpp"
 #include "keys.hpp"
-#include "util.hpp"
 
 #include <string>
 
@@ -14,7 +14,7 @@
 
 namespace snake
 {
-    struct Context;
+    struct FrontEndContext;
     class GameConfig;
     class Media;
 
@@ -22,12 +22,23 @@ namespace snake
     struct IRegion
     {
         virtual ~IRegion() = default;
-        virtual void reset(const Context & context) = 0;
+        virtual void reset(const FrontEndContext & context) = 0;
         virtual const sf::FloatRect bounds() const = 0;
-        virtual void updateText(const Context & context) = 0;
-        virtual void update(Context &, const float elapsedSec) = 0;
-        virtual void handleEvent(Context & context, const sf::Event & event) = 0;
-        virtual void draw(const Context &, sf::RenderTarget &, sf::RenderStates) const = 0;
+        virtual void updateText(const FrontEndContext & context) = 0;
+        virtual void update(FrontEndContext &, const float elapsedSec) = 0;
+        virtual void handleEvent(FrontEndContext & context, const sf::Event & event) = 0;
+        virtual void draw(const FrontEndContext &, sf::RenderTarget &, sf::RenderStates) const = 0;
+    };
+
+    // does nothing, for when there is no window to draw to, see GameConfig::is_headless
+    struct NullRegion final : public IRegion
+    {
+        void reset(const FrontEndContext &) override {}
+        const sf::FloatRect bounds() const override { return {}; }
+        void updateText(const FrontEndContext &) override {}
+        void update(FrontEndContext &, const float) override {}
+        void handleEvent(FrontEndContext &, const sf::Event &) override {}
+        void draw(const FrontEndContext &, sf::RenderTarget &, sf::RenderStates) const override {}
     };
 
     //
@@ -38,14 +49,14 @@ namespace snake
         StatusText() = default;
 
         StatusText(
-            const Context & context,
+            const FrontEndContext & context,
             const std::string & prefix,
             const std::size_t digitCount,
             const sf::Color & color,
             const float height);
 
         void setup(
-            const Context & context,
+            const FrontEndContext & context,
             const std::string & prefix,
             const std::size_t digitCount,
             const sf::Color & color,
@@ -121,15 +132,15 @@ namespace snake
         StatusRegion() = default;
         virtual ~StatusRegion() override = default;
 
-        void reset(const Context & context) override;
+        void reset(const FrontEndContext & context) override;
 
         const sf::FloatRect bounds() const override { return m_statusBounds; }
         const sf::FloatRect textBounds() const { return m_textBounds; }
-        void update(Context &, const float) override {}
-        void handleEvent(Context &, const sf::Event &) override {}
-        void draw(const Context &, sf::RenderTarget &, sf::RenderStates) const override;
+        void update(FrontEndContext &, const float) override {}
+        void handleEvent(FrontEndContext &, const sf::Event &) override {}
+        void draw(const FrontEndContext &, sf::RenderTarget &, sf::RenderStates) const override;
 
-        void updateText(const Context & context) override;
+        void updateText(const FrontEndContext & context) override;
 
       private:
         sf::FloatRect m_statusBounds;
@@ -0,0 +1,91 @@
+#ifndef SNAKE_TAIL_GRADIENT_SHADER_HPP_INCLUDED
+#define SNAKE_TAIL_GRADIENT_SHADER_HPP_INCLUDED
+//
+// tail-gradient-shader.hpp
+//
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include <SFML/Graphics.hpp>
+
+namespace snake
+{
+    // Colors the tail from light (next to the head) to dark (the end) at draw time, so moving
+    // or shrinking never has to re-write every tail vertex.  Each tail quad is stamped once
+    // with its sequence number in texCoords.x and a 1 in texCoords.y, and every other quad
+    // has 0 in texCoords.y so it keeps its own vertex color.  No texture is ever bound while
+    // the board draws, so SFML leaves texCoords as-is instead of normalizing them.
+    class TailGradientShader
+    {
+      public:
+        TailGradientShader() = default;
+
+        // needs an OpenGL context so only call after the window is open, safe to call again
+        bool load(const sf::Color & colorNearHead, const sf::Color & colorAtEnd)
+        {
+            if (m_isLoaded)
+            {
+                return true;
+            }
+
+            if (!sf::Shader::isAvailable())
+            {
+                return false;
+            }
+
+            m_isLoaded = m_shader.loadFromMemory(m_vertexShaderCode, m_fragmentShaderCode);
+
+            if (m_isLoaded)
+            {
+                m_shader.setUniform("colorNearHead", sf::Glsl::Vec4(colorNearHead));
+                m_shader.setUniform("colorAtEnd", sf::Glsl::Vec4(colorAtEnd));
+            }
+
+            return m_isLoaded;
+        }
+
+        bool isLoaded() const { return m_isLoaded; }
+
+        // the only per-turn work, and it does not depend on how long the tail is
+        void update(const float newestSequence, const std::size_t tailLength)
+        {
+            m_shader.setUniform("newestSequence", newestSequence);
+
+            m_shader.setUniform(
+                "tailLength", static_cast<float>(std::max(std::size_t(1), tailLength)));
+        }
+
+        const sf::Shader * shader() const { return ((m_isLoaded) ? &m_shader : nullptr); }
+
+      private:
+        sf::Shader m_shader;
+        bool m_isLoaded{ false };
+
+        static inline const std::string m_vertexShaderCode{ "\
+uniform float newestSequence;\
+uniform float tailLength;\
+uniform vec4 colorNearHead;\
+uniform vec4 colorAtEnd;\
+\
+void main()\
+{\
+    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\
+    gl_FrontColor = gl_Color;\
+\
+    if (gl_MultiTexCoord0.y > 0.5)\
+    {\
+        float ratio = clamp((newestSequence - gl_MultiTexCoord0.x) / tailLength, 0.0, 1.0);\
+        gl_FrontColor = vec4(mix(colorNearHead.rgb, colorAtEnd.rgb, ratio), gl_Color.a);\
+    }\
+}" };
+
+        static inline const std::string m_fragmentShaderCode{ "\
+void main()\
+{\
+    gl_FragColor = gl_Color;\
+}" };
+    };
+} // namespace snake
+
+#endif // SNAKE_TAIL_GRADIENT_SHADER_HPP_INCLUDED
@@ -6,10 +6,11 @@
 #include "check-macros.hpp"
 #include "common-types.hpp"
 #include "context.hpp"
+#include "graphics-util.hpp"
 #include "media.hpp"
+#include "pixel-layout.hpp"
 #include "random.hpp"
 #include "settings.hpp"
-#include "util.hpp"
 
 #include <vector>
 
@@ -19,14 +20,14 @@
 
 namespace snake
 {
-    struct Context;
+    struct FrontEndContext;
 
     //
 
     struct Star : public sf::Drawable
     {
         explicit Star(
-            const Context & context,
+            const FrontEndContext & context,
             const sf::Vector2f & position,
             const sf::Color & color,
             const sf::Vector2f & vel = { 0.0f, 0.0f })
@@ -35,7 +36,7 @@ namespace snake
         }
 
         void reset(
-            const Context & context,
+            const FrontEndContext & context,
             const sf::Vector2f & position,
             const sf::Color & color,
             const sf::Vector2f & vel = { 0.0f, 0.0f })
@@ -45,7 +46,8 @@ namespace snake
             velocity = vel;
 
             dimm_max_size = 4.0f;
-            dimm_max_size += (static_cast<float>(context.layout.window_size.x) / 100.0f);
+            dimm_max_size +=
+                (static_cast<float>(context.pixel_layout.window_size.x) / 100.0f);
 
             sprite.setTexture(context.media.starTexture());
             util::setOriginToCenter(sprite);
@@ -58,7 +60,7 @@ namespace snake
         float ageRatio() const { return std::clamp((elapsed_sec / duration_sec), 0.0f, 1.0f); }
         bool isGrowing() const { return (ageRatio() < 0.5f); }
 
-        void update(Context &, const float elapsedSec)
+        void update(FrontEndContext &, const float elapsedSec)
         {
             if (!isAlive())
             {
@@ -155,9 +157,9 @@ namespace snake
       public:
         TeleportEffect() = default;
 
-        TeleportEffect(const Context & context) { reset(context); }
+        TeleportEffect(const FrontEndContext & context) { reset(context); }
 
-        void reset(const Context &)
+        void reset(const FrontEndContext &)
         {
             m_stars.clear();
             m_stars.reserve(1000);
@@ -169,7 +171,7 @@ namespace snake
             elapsed_sec = 0.0f;
         }
 
-        void update(Context & context, const float elpasedTimeSec)
+        void update(FrontEndContext & context, const float elpasedTimeSec)
         {
             elapsed_sec += elpasedTimeSec;
             if (elapsed_sec > sec_until_spawn)
@@ -220,14 +222,14 @@ namespace snake
         }
 
         void
-            add(const Context & context,
+            add(const FrontEndContext & context,
                 const BoardPos_t & boardPos,
                 const sf::Color & color = sf::Color::White,
                 const sf::Vector2f & velocity = { 0.0f, 0.0f })
         {
             // make the bounds bigger so that some of the sparkles are just past the edges
             const sf::FloatRect bounds{ util::scaleRectInPlaceCopy(
-                context.layout.cellBounds(boardPos), 2.0f) };
+                context.pixel_layout.cellBounds(boardPos), 2.0f) };
 
             add(bounds, color, velocity);
         }
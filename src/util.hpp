@@ -3,14 +3,19 @@
 //
 // util.hpp
 //
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
 
 //
 
@@ -191,13 +196,6 @@ namespace util
         return static_cast<Ratio_t>((number - inMin) / (inMax - inMin));
     }
 
-    inline constexpr sf::Uint8 mapRatioToColorValue(const float ratio)
-    {
-        return map(std::clamp(ratio, 0.0f, 1.0f), 0.0f, 1.0f, sf::Uint8(0), sf::Uint8(255));
-    }
-
-    constexpr std::size_t verts_per_quad{ 4 };
-
     template <typename Container_t>
     [[nodiscard]] inline std::string containerToString(
         const Container_t & container,
@@ -234,65 +232,6 @@ namespace util
             return (wrapFront + content + wrapBack);
         }
     };
-
-    [[nodiscard]] inline const std::string colorToString(const sf::Color & C)
-    {
-        std::string str;
-        str.reserve(16);
-
-        str += '(';
-
-        if (sf::Color::Black == C)
-        {
-            str += "Black";
-        }
-        else if (sf::Color::White == C)
-        {
-            str += "White";
-        }
-        else if (sf::Color::Red == C)
-        {
-            str += "Red";
-        }
-        else if (sf::Color::Green == C)
-        {
-            str += "Green";
-        }
-        else if (sf::Color::Blue == C)
-        {
-            str += "Blue";
-        }
-        else if (sf::Color::Yellow == C)
-        {
-            str += "Yellow";
-        }
-        else if (sf::Color::Magenta == C)
-        {
-            str += "Magenta";
-        }
-        else if (sf::Color::Cyan == C)
-        {
-            str += "Cyan";
-        }
-        else
-        {
-            str += std::to_string(static_cast<unsigned>(C.r));
-            str += ',';
-            str += std::to_string(static_cast<unsigned>(C.g));
-            str += ',';
-            str += std::to_string(static_cast<unsigned>(C.b));
-
-            if (C.a != 255)
-            {
-                str += ',';
-                str += std::to_string(static_cast<unsigned>(C.a));
-            }
-        }
-
-        str += ')';
-
-        return str;
-    }
 } // namespace util
 
 //
@@ -336,57 +275,12 @@ namespace sf
 
     //
 
-    template <typename T>
-    [[nodiscard]] bool operator<(const sf::Rect<T> & r1, const sf::Rect<T> & r2)
-    {
-        return (
-            std::tie(r1.top, r1.left, r1.width, r1.height) <
-            std::tie(r2.top, r2.left, r2.width, r2.height));
-    }
-
-    //
-
     template <typename T>
     std::ostream & operator<<(std::ostream & os, const sf::Vector2<T> & vec)
     {
         os << '(' << vec.x << 'x' << vec.y << ')';
         return os;
     }
-
-    template <typename T>
-    std::ostream & operator<<(std::ostream & os, const sf::Rect<T> & rect)
-    {
-        os << '(' << rect.left << ',' << rect.top << '/' << rect.width << 'x' << rect.height << ')';
-        return os;
-    }
-
-    inline std::ostream & operator<<(std::ostream & os, const sf::Color & C)
-    {
-        os << util::colorToString(C);
-        return os;
-    }
-
-    inline std::ostream & operator<<(std::ostream & os, const sf::Vertex & vert)
-    {
-        os << "(pos=" << vert.position << ", col=" << vert.color << ", tc=" << vert.texCoords
-           << ")";
-
-        return os;
-    }
-
-    inline std::ostream & operator<<(std::ostream & os, const sf::VideoMode & vm)
-    {
-        os << "(" << vm.width << "x" << vm.height << ":" << vm.bitsPerPixel << "bpp";
-
-        if (!vm.isValid())
-        {
-            os << "(sfml says this mode is invalid)";
-        }
-
-        os << ")";
-
-        return os;
-    }
 } // namespace sf
 
 //
@@ -402,42 +296,6 @@ namespace util
             std::unique(std::begin(container), std::end(container)), std::end(container));
     }
 
-    [[nodiscard]] inline std::string makeSupportedVideoModesString(
-        const bool willSkipDiffBitsPerPixel = false, const std::string & separator = "\n")
-    {
-        const unsigned int desktopBitsPerPixel{ sf::VideoMode::getDesktopMode().bitsPerPixel };
-
-        std::vector<sf::VideoMode> videoModes{ sf::VideoMode::getFullscreenModes() };
-        std::reverse(std::begin(videoModes), std::end(videoModes));
-
-        const std::size_t modeCountOrig{ videoModes.size() };
-
-        std::size_t count{ 0 };
-        std::ostringstream ss;
-        for (const sf::VideoMode & vm : videoModes)
-        {
-            if (willSkipDiffBitsPerPixel && (vm.bitsPerPixel != desktopBitsPerPixel))
-            {
-                continue;
-            }
-
-            if (count > 0)
-            {
-                ss << separator;
-            }
-
-            ss << vm;
-            ++count;
-        }
-
-        const std::size_t modeCountReturned{ count };
-
-        ss << separator << "(total_supported=" << modeCountOrig << ")";
-        ss << separator << "(total_listed=" << modeCountReturned << ")";
-
-        return ss.str();
-    }
-
     // bit hacking
 
     template <typename T, typename U>
@@ -546,116 +404,12 @@ namespace util
         return (std::abs(value) < tiny);
     }
 
-    //
-
-    template <typename T>
-    [[nodiscard]] sf::Rect<T> floor(const sf::Rect<T> & rect)
-    {
-        return { std::floor(rect.left),
-                 std::floor(rect.top),
-                 std::floor(rect.width),
-                 std::floor(rect.height) };
-    }
-
     template <typename T>
     [[nodiscard]] sf::Vector2<T> floor(const sf::Vector2<T> & vec)
     {
         return { std::floor(vec.x), std::floor(vec.y) };
     }
 
-    // position, size, and center
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2<T> position(const sf::Rect<T> & rect)
-    {
-        return { rect.left, rect.top };
-    }
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2f position(const T & thing)
-    {
-        return position(thing.getGlobalBounds());
-    }
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2f positionLocal(const T & thing)
-    {
-        return position(thing.getLocalBounds());
-    }
-
-    template <typename T>
-    [[nodiscard]] T right(const sf::Rect<T> & rect)
-    {
-        return (rect.left + rect.width);
-    }
-
-    template <typename T>
-    [[nodiscard]] float right(const T & thing)
-    {
-        return right(thing.getGlobalBounds());
-    }
-
-    template <typename T>
-    [[nodiscard]] T bottom(const sf::Rect<T> & rect)
-    {
-        return (rect.top + rect.height);
-    }
-
-    template <typename T>
-    [[nodiscard]] float bottom(const T & thing)
-    {
-        return bottom(thing.getGlobalBounds());
-    }
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2<T> size(const sf::Rect<T> & rect)
-    {
-        return { rect.width, rect.height };
-    }
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2f size(const T & thing)
-    {
-        return size(thing.getGlobalBounds());
-    }
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2f sizeLocal(const T & thing)
-    {
-        return size(thing.getLocalBounds());
-    }
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2<T> center(const sf::Rect<T> & rect)
-    {
-        return (position(rect) + (size(rect) / T(2)));
-    }
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2f center(const T & thing)
-    {
-        return center(thing.getGlobalBounds());
-    }
-
-    template <typename T>
-    [[nodiscard]] sf::Vector2f centerLocal(const T & thing)
-    {
-        return center(thing.getLocalBounds());
-    }
-
-    template <typename T>
-    void setOriginToCenter(T & thing)
-    {
-        thing.setOrigin(centerLocal(thing));
-    }
-
-    // sf::Text needs correction after changing the: string, scale, or characterSize
-    template <typename T>
-    void setOriginToPosition(T & thing)
-    {
-        thing.setOrigin(positionLocal(thing));
-    }
-
     template <typename T>
     void makeEven(T number, const bool willAdd)
     {
@@ -790,442 +544,6 @@ namespace util
         return angleFromVector(difference(from, to));
     }
 
-    template <typename T, typename U = T>
-    [[nodiscard]] float angleFromTo(const T & from, const U & to)
-    {
-        sf::Vector2f fromPos{ 0.0f, 0.0f };
-        if constexpr (std::is_same_v<std::remove_cv_t<T>, sf::Vector2f>)
-        {
-            fromPos = from;
-        }
-        else
-        {
-            fromPos = center(from);
-        }
-
-        sf::Vector2f toPos{ 0.0f, 0.0f };
-        if constexpr (std::is_same_v<std::remove_cv_t<U>, sf::Vector2f>)
-        {
-            toPos = to;
-        }
-        else
-        {
-            toPos = center(to);
-        }
-
-        return angleFromTo(fromPos, toPos);
-    }
-
-    template <typename T>
-    void aimAtPosition(T & thing, const sf::Vector2f & pos)
-    {
-        thing.setRotation(angleFromTo(center(thing), pos));
-    }
-
-    template <typename T>
-    void aimWithVector(T & thing, const sf::Vector2f & velocity)
-    {
-        thing.setRotation(angleFromVector(velocity));
-    }
-
-    // scales, offsets, and local bounds
-
-    // sfml utils to re-size (scale) any sf::FloatRect without moving it
-    inline void scaleRectInPlace(sf::FloatRect & rect, const sf::Vector2f & scale) noexcept
-    {
-        const auto widthChange((rect.width * scale.x) - rect.width);
-        rect.width += widthChange;
-        rect.left -= (widthChange * 0.5f);
-
-        const float heightChange((rect.height * scale.y) - rect.height);
-        rect.height += heightChange;
-        rect.top -= (heightChange * 0.5f);
-    }
-
-    [[nodiscard]] inline sf::FloatRect
-        scaleRectInPlaceCopy(const sf::FloatRect & before, const sf::Vector2f & scale) noexcept
-    {
-        sf::FloatRect after(before);
-        scaleRectInPlace(after, scale);
-        return after;
-    }
-
-    inline void scaleRectInPlace(sf::FloatRect & rect, const float scale) noexcept
-    {
-        scaleRectInPlace(rect, { scale, scale });
-    }
-
-    [[nodiscard]] inline sf::FloatRect
-        scaleRectInPlaceCopy(const sf::FloatRect & before, const float scale) noexcept
-    {
-        sf::FloatRect after(before);
-        scaleRectInPlace(after, scale);
-        return after;
-    }
-
-    inline void adjRectInPlace(sf::FloatRect & rect, const float amount) noexcept
-    {
-        rect.left += amount;
-        rect.top += amount;
-        rect.width -= (amount * 2.0f);
-        rect.height -= (amount * 2.0f);
-    }
-
-    [[nodiscard]] inline sf::FloatRect
-        adjRectInPlaceCopy(const sf::FloatRect & before, const float amount) noexcept
-    {
-        sf::FloatRect after(before);
-        adjRectInPlace(after, amount);
-        return after;
-    }
-
-    // re-sizing (scaling), centering, and all while maintaining origins
-
-    // without changing the shape
-    template <typename T>
-    void fit(T & thing, const sf::Vector2f & size)
-    {
-        // skip if source size is zero (or close) to avoid dividing by zero below
-        const sf::FloatRect localBounds{ thing.getLocalBounds() };
-        if ((localBounds.width < 1.0f) || (localBounds.height < 1.0f))
-        {
-            return;
-        }
-
-        const float scaleHoriz{ size.x / localBounds.width };
-        thing.setScale(scaleHoriz, scaleHoriz);
-
-        if (thing.getGlobalBounds().height > size.y)
-        {
-            const float scaleVert{ size.y / localBounds.height };
-            thing.setScale(scaleVert, scaleVert);
-        }
-
-        if constexpr (std::is_same_v<std::remove_cv_t<T>, sf::Text>)
-        {
-            setOriginToPosition(thing);
-        }
-    }
-
-    template <typename T>
-    void fit(T & thing, const sf::FloatRect & rect)
-    {
-        fit(thing, { rect.width, rect.height });
-    }
-
-    template <typename T>
-    void fit(T & thing, const float newScale)
-    {
-        fit(thing, { newScale, newScale });
-    }
-
-    template <typename T>
-    void centerInside(T & thing, const sf::FloatRect & rect)
-    {
-        thing.setPosition((center(rect) - (size(thing) * 0.5f)) + thing.getOrigin());
-    }
-
-    template <typename T>
-    void fitAndCenterInside(T & thing, const sf::FloatRect & rect)
-    {
-        fit(thing, rect);
-        centerInside(thing, rect);
-    }
-
-    // quad making and appending
-
-    template <typename Container_t>
-    void setupQuadVerts(
-        const sf::Vector2f & pos,
-        const sf::Vector2f & size,
-        const std::size_t index,
-        Container_t & verts,
-        const sf::Color & color = sf::Color::Transparent)
-    {
-        // clang-format off
-        verts[index + 0].position = pos;
-        verts[index + 1].position = sf::Vector2f((pos.x + size.x),  pos.y          );
-        verts[index + 2].position = sf::Vector2f((pos.x + size.x), (pos.y + size.y));
-        verts[index + 3].position = sf::Vector2f( pos.x          , (pos.y + size.y));
-        // clang-format on
-
-        if (color != sf::Color::Transparent)
-        {
-            verts[index + 0].color = color;
-            verts[index + 1].color = color;
-            verts[index + 2].color = color;
-            verts[index + 3].color = color;
-        }
-    }
-
-    template <typename Container_t>
-    void setupQuadVerts(
-        const sf::FloatRect & rect,
-        const std::size_t index,
-        Container_t & verts,
-        const sf::Color & color = sf::Color::Transparent)
-    {
-        setupQuadVerts(position(rect), size(rect), index, verts, color);
-    }
-
-    template <typename Container_t>
-    void appendQuadVerts(
-        const sf::Vector2f & pos,
-        const sf::Vector2f & size,
-        Container_t & verts,
-        const sf::Color & color = sf::Color::Transparent)
-    {
-        std::size_t origSize{ 0 };
-        if constexpr (std::is_same_v<std::remove_cv_t<Container_t>, sf::VertexArray>)
-        {
-            origSize = verts.getVertexCount();
-        }
-        else
-        {
-            origSize = verts.size();
-        }
-
-        verts.resize(origSize + 4);
-
-        setupQuadVerts(pos, size, origSize, verts, color);
-    }
-
-    template <typename Container_t>
-    void appendQuadVerts(
-        const sf::FloatRect & rect,
-        Container_t & verts,
-        const sf::Color & color = sf::Color::Transparent)
-    {
-        appendQuadVerts(position(rect), size(rect), verts, color);
-    }
-
-    // slow running but handy debugging shapes
-
-    [[nodiscard]] inline sf::VertexArray
-        makeRectangleVerts(const sf::FloatRect & rect, const sf::Color & color = sf::Color::White)
-    {
-        sf::VertexArray verts(sf::Quads, 4);
-        setupQuadVerts(position(rect), size(rect), 0, verts, color);
-        return verts;
-    }
-
-    inline void drawRectangleVerts(
-        sf::RenderTarget & target,
-        const sf::FloatRect & rect,
-        const sf::Color & color = sf::Color::White)
-    {
-        target.draw(makeRectangleVerts(rect, color));
-    }
-
-    [[nodiscard]] inline sf::RectangleShape makeRectangleShape(
-        const sf::FloatRect & rect,
-        const bool willColorFill = false,
-        const sf::Color & color = sf::Color::White)
-    {
-        sf::RectangleShape rs;
-
-        rs.setOutlineThickness(1.0f);
-        rs.setOutlineColor(color);
-
-        if (willColorFill)
-        {
-            rs.setFillColor(color);
-        }
-        else
-        {
-            rs.setFillColor(sf::Color::Transparent);
-        }
-
-        rs.setPosition(position(rect));
-        rs.setSize(size(rect));
-        return rs;
-    }
-
-    inline void drawRectangleShape(
-        sf::RenderTarget & target,
-        const sf::FloatRect & rect,
-        const bool willColorFill = false,
-        const sf::Color & color = sf::Color::White)
-    {
-        target.draw(makeRectangleShape(rect, willColorFill, color));
-    }
-
-    [[nodiscard]] inline sf::CircleShape makeCircleShape(
-        const sf::Vector2f & position,
-        const float radius,
-        const sf::Color & color = sf::Color::White,
-        const std::size_t pointCount = 32)
-    {
-        sf::CircleShape cs;
-        cs.setFillColor(color);
-        cs.setPointCount(pointCount);
-        cs.setRadius(radius);
-        setOriginToCenter(cs);
-        cs.setPosition(position);
-        return cs;
-    }
-
-    inline void drawCircleShape(
-        sf::RenderTarget & target,
-        const sf::Vector2f & position,
-        const float radius,
-        const sf::Color & color = sf::Color::White,
-        const std::size_t pointCount = 32)
-    {
-        target.draw(makeCircleShape(position, radius, color, pointCount));
-    }
-
-    [[nodiscard]] inline sf::CircleShape makeCircleShape(
-        const sf::FloatRect & rect,
-        const sf::Color & color = sf::Color::White,
-        const std::size_t pointCount = 32)
-    {
-        return makeCircleShape(
-            center(rect), (std::min(rect.width, rect.height) * 0.5f), color, pointCount);
-    }
-
-    inline void drawCircle(
-        sf::RenderTarget & target,
-        const sf::FloatRect & rect,
-        const sf::Color & color = sf::Color::White)
-    {
-        target.draw(makeCircleShape(rect, color));
-    }
-
-    inline sf::VertexArray makeLines(
-        const std::vector<sf::Vector2f> & points, const sf::Color & color = sf::Color::White)
-    {
-        sf::VertexArray va(sf::Lines);
-
-        for (const sf::Vector2f & point : points)
-        {
-            va.append(sf::Vertex(point, color));
-        }
-
-        return va;
-    }
-
-    inline sf::VertexArray makeLines(
-        const std::initializer_list<sf::Vector2f> & initListPoints,
-        const sf::Color & color = sf::Color::White)
-    {
-        std::vector<sf::Vector2f> points;
-        points.reserve(initListPoints.size());
-
-        for (const sf::Vector2f & point : points)
-        {
-            points.push_back(point);
-        }
-
-        return makeLines(points, color);
-    }
-
-    inline void drawlines(
-        sf::RenderTarget & target,
-        const std::vector<sf::Vector2f> & points,
-        const sf::Color & color = sf::Color::White)
-    {
-        target.draw(makeLines(points, color));
-    }
-
-    inline void drawlines(
-        sf::RenderTarget & target,
-        const std::initializer_list<sf::Vector2f> & points,
-        const sf::Color & color = sf::Color::White)
-    {
-        target.draw(makeLines(points, color));
-    }
-
-    // more misc sfml
-
-    inline sf::Color colorBlend(
-        const float ratio,
-        const sf::Color & fromColor,
-        const sf::Color & toColor,
-        const bool willIgnoreAlpha = false)
-    {
-        if (ratio < 0.0f)
-        {
-            return fromColor;
-        }
-
-        if (ratio > 1.0f)
-        {
-            return toColor;
-        }
-
-        auto calcColorValue = [ratio](const sf::Uint8 fromVal, const sf::Uint8 toVal) {
-            const float diff{ static_cast<float>(toVal) - static_cast<float>(fromVal) };
-            const float finalValue{ static_cast<float>(fromVal) + (diff * ratio) };
-            return static_cast<sf::Uint8>(finalValue);
-        };
-
-        sf::Color color{ toColor };
-        color.r = calcColorValue(fromColor.r, toColor.r);
-        color.g = calcColorValue(fromColor.g, toColor.g);
-        color.b = calcColorValue(fromColor.b, toColor.b);
-
-        if (!willIgnoreAlpha)
-        {
-            color.a = calcColorValue(fromColor.a, toColor.a);
-        }
-
-        return color;
-    }
-
-    inline sf::Color colorStepToward(
-        const sf::Uint8 stepSize,
-        const sf::Color & fromColor,
-        const sf::Color & toColor,
-        const bool willIgnoreAlpha = false)
-    {
-        if (0 == stepSize)
-        {
-            return fromColor;
-        }
-
-        if (255 == stepSize)
-        {
-            return toColor;
-        }
-
-        auto calcColorValue = [stepSize](const sf::Uint8 fromVal, const sf::Uint8 toVal) {
-            if (fromVal == toVal)
-            {
-                return fromVal;
-            }
-
-            const int stepInt{ static_cast<int>(stepSize) };
-            const int fromInt{ static_cast<int>(fromVal) };
-            const int toInt{ static_cast<int>(toVal) };
-            const int diff{ std::min(std::abs(toInt - fromInt), stepInt) };
-
-            int finalValue{ fromInt };
-            if (toVal > fromVal)
-            {
-                finalValue += diff;
-            }
-            else
-            {
-                finalValue -= diff;
-            }
-
-            return static_cast<sf::Uint8>(std::clamp(finalValue, 0, 255));
-        };
-
-        sf::Color color{ toColor };
-        color.r = calcColorValue(fromColor.r, toColor.r);
-        color.g = calcColorValue(fromColor.g, toColor.g);
-        color.b = calcColorValue(fromColor.b, toColor.b);
-
-        if (!willIgnoreAlpha)
-        {
-            color.a = calcColorValue(fromColor.a, toColor.a);
-        }
-
-        return color;
-    }
-
     // statistics
 
     template <typename T>
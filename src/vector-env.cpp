@@ -0,0 +1,212 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// vector-env.cpp
+//
+#include "vector-env.hpp"
+
+#include "check-macros.hpp"
+#include "keys.hpp"
+#include "pieces.hpp"
+
+#include "random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace snake
+{
+    VectorEnv::VectorEnv(
+        const GameConfig & config, const std::size_t envCount, const Seed_t baseSeed)
+        : m_config(config)
+        , m_layout()
+        , m_worlds()
+        , m_baseSeed(baseSeed)
+        , m_nextSeed(baseSeed)
+        , m_wordsPerPlane(0)
+        , m_envStepCount(0)
+        , m_observations()
+        , m_playerCells()
+        , m_rewards()
+        , m_dones()
+        , m_livesLost()
+    {
+        M_CHECK_SS((envCount > 0), envCount);
+
+        // the actions given to step() are the only thing driving the player
+        m_config.is_headless = true;
+        m_config.will_ai_drive_player = false;
+
+        M_CHECK_SS((m_config.sim_ticks_per_sec > 0), m_config.sim_ticks_per_sec);
+        M_CHECK_SS((m_config.headless_tick_limit > 0), m_config.headless_tick_limit);
+
+        if ((0 == m_config.resolution.x) || (0 == m_config.resolution.y))
+        {
+            m_config.resolution = m_defaultResolution;
+        }
+
+        m_layout.reset(m_config);
+
+        m_wordsPerPlane = util::BitBoard(m_layout.cell_count_total_st).words().size();
+
+        m_worlds.reserve(envCount);
+        for (std::size_t envIndex(0); envIndex < envCount; ++envIndex)
+        {
+            m_worlds.push_back(std::make_unique<BatchWorld>(m_config, m_layout));
+        }
+
+        m_observations.resize(envCount * wordsPerEnv(), 0);
+        m_playerCells.resize(envCount, 0);
+        m_rewards.resize(envCount, 0);
+        m_dones.resize(envCount, 0);
+        m_livesLost.resize(envCount, 0);
+
+        reset();
+    }
+
+    void VectorEnv::reset()
+    {
+        m_nextSeed = m_baseSeed;
+
+        for (std::size_t envIndex(0); envIndex < m_worlds.size(); ++envIndex)
+        {
+            startEnv(envIndex);
+            m_rewards[envIndex] = 0;
+            m_dones[envIndex] = 0;
+            m_livesLost[envIndex] = 0;
+            observe(envIndex);
+        }
+    }
+
+    void VectorEnv::step(const std::vector<sf::Keyboard::Key> & actions)
+    {
+        M_CHECK_SS(
+            (actions.size() == m_worlds.size()),
+            "actions.size()=" << actions.size() << ", envCount()=" << m_worlds.size());
+
+        for (std::size_t envIndex(0); envIndex < m_worlds.size(); ++envIndex)
+        {
+            stepEnv(envIndex, actions[envIndex]);
+        }
+
+        m_envStepCount += m_worlds.size();
+    }
+
+    void VectorEnv::benchmark(const std::size_t stepCount, const Seed_t seed)
+    {
+        const util::Random random(seed);
+        std::vector<sf::Keyboard::Key> actions(envCount(), keys::not_a_key);
+
+        long long rewardSum{ 0 };
+        std::size_t doneCount{ 0 };
+        const std::size_t envStepCountBefore{ m_envStepCount };
+        const auto startTime{ std::chrono::steady_clock::now() };
+
+        for (std::size_t stepIndex(0); stepIndex < stepCount; ++stepIndex)
+        {
+            for (sf::Keyboard::Key & action : actions)
+            {
+                action = random.from({ keys::not_a_key,
+                                       sf::Keyboard::Up,
+                                       sf::Keyboard::Down,
+                                       sf::Keyboard::Left,
+                                       sf::Keyboard::Right });
+            }
+
+            step(actions);
+
+            for (std::size_t envIndex(0); envIndex < envCount(); ++envIndex)
+            {
+                rewardSum += m_rewards[envIndex];
+                doneCount += m_dones[envIndex];
+            }
+        }
+
+        const std::chrono::duration<double> runTime{ std::chrono::steady_clock::now() -
+                                                     startTime };
+
+        const std::size_t envStepsTaken{ m_envStepCount - envStepCountBefore };
+
+        std::cout << "Envs: " << envCount() << " of " << m_layout.cell_counts.x << 'x'
+                  << m_layout.cell_counts.y << " cells, " << wordsPerEnv()
+                  << " observation words each\n";
+
+        std::cout << "Env-Steps: " << envStepsTaken << " (" << doneCount << " games over, "
+                  << rewardSum << " score)\n";
+
+        std::cout << "Env-Steps/Sec: "
+                  << (static_cast<double>(envStepsTaken) / std::max(0.001, runTime.count()))
+                  << std::endl;
+    }
+
+    const VectorEnv::Word_t * VectorEnv::observation(const std::size_t envIndex) const
+    {
+        M_CHECK_SS((envIndex < m_worlds.size()), envIndex);
+        return &m_observations[envIndex * wordsPerEnv()];
+    }
+
+    void VectorEnv::startEnv(const std::size_t envIndex)
+    {
+        m_worlds[envIndex]->start(m_nextSeed++);
+    }
+
+    void VectorEnv::stepEnv(const std::size_t envIndex, const sf::Keyboard::Key action)
+    {
+        BatchWorld & world{ *m_worlds[envIndex] };
+        const GameInPlay & game{ world.game() };
+
+        const int scoreBefore{ game.score() };
+        const std::size_t lifeLostCountBefore{ world.lifeLostCount() };
+        const std::size_t levelBefore{ game.level().number };
+        const std::size_t cellBefore{ world.playerCellIndex() };
+
+        if (keys::isArrow(action))
+        {
+            world.handleKey(action);
+        }
+
+        // every turn moves the head, and anything that ends the turn early reloads the level
+        bool isPlaying{ true };
+        while (isPlaying)
+        {
+            isPlaying = world.tick();
+
+            if ((world.playerCellIndex() != cellBefore) ||
+                (world.lifeLostCount() != lifeLostCountBefore) ||
+                (game.level().number != levelBefore))
+            {
+                break;
+            }
+        }
+
+        m_rewards[envIndex] = (game.score() - scoreBefore);
+        m_livesLost[envIndex] = ((world.lifeLostCount() != lifeLostCountBefore) ? 1 : 0);
+        m_dones[envIndex] = ((isPlaying) ? 0 : 1);
+
+        if (!isPlaying)
+        {
+            startEnv(envIndex);
+        }
+
+        observe(envIndex);
+    }
+
+    void VectorEnv::observe(const std::size_t envIndex)
+    {
+        const BatchWorld & world{ *m_worlds[envIndex] };
+
+        Word_t * const envWords{ &m_observations[envIndex * wordsPerEnv()] };
+        for (std::size_t planeIndex(0); planeIndex < planeCount(); ++planeIndex)
+        {
+            const std::vector<Word_t> & words{
+                world.board().pieceBits(static_cast<Piece>(planeIndex)).words()
+            };
+
+            std::copy(
+                std::begin(words), std::end(words), (envWords + (planeIndex * m_wordsPerPlane)));
+        }
+
+        m_playerCells[envIndex] = static_cast<std::uint32_t>(world.playerCellIndex());
+    }
+} // namespace snake
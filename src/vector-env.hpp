@@ -0,0 +1,107 @@
+#ifndef SNAKE_VECTOR_ENV_HPP_INCLUDED
+#define SNAKE_VECTOR_ENV_HPP_INCLUDED
+//
+// vector-env.hpp
+//
+#include "batch-simulator.hpp"
+#include "bit-board.hpp"
+#include "layout.hpp"
+#include "settings.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SFML/Window/Keyboard.hpp>
+
+namespace snake
+{
+    // Many games stepped together one player turn at a time, for training bots to play.  Each
+    // environment is its own BatchWorld playing by the same rules as the real game, with its
+    // own Board and pieces, so the games themselves are not laid out side by side in memory.
+    // Only what step() hands back is, as one array per kind of result with one entry per
+    // environment, so a whole batch can be read without touching any of the Boards.
+    //
+    // The player is never driven by the AI here, only by the actions given to step(), but
+    // rival snakes still are.  Every game that ends is started again right away with the next
+    // seed, and the observation is of the new game with dones() set for that step.
+    class VectorEnv
+    {
+      public:
+        using Word_t = util::BitBoard::Word_t;
+
+        VectorEnv(const GameConfig & config, const std::size_t envCount, const Seed_t baseSeed);
+
+        // prevent all copy and assignment
+        VectorEnv(const VectorEnv &) = delete;
+        VectorEnv(VectorEnv &&) = delete;
+        //
+        VectorEnv & operator=(const VectorEnv &) = delete;
+        VectorEnv & operator=(VectorEnv &&) = delete;
+
+        // starts every environment on a new game, seeded in order starting from baseSeed
+        void reset();
+
+        // One arrow key per environment (or keys::not_a_key to keep going straight) pressed
+        // just before the player's next turn, then ticks each game until the player has taken
+        // that turn, lost a life, or finished the level.  The key goes through
+        // HeadPiece::handleEvent() like any other, so keys that reverse are ignored.
+        void step(const std::vector<sf::Keyboard::Key> & actions);
+
+        std::size_t envCount() const { return m_worlds.size(); }
+        const Layout & layout() const { return m_layout; }
+
+        // One plane per Piece (in piece::toIndex() order) of one bit per Layout::cellIndex(),
+        // packed the same as util::BitBoard and stored one environment after another.
+        static constexpr std::size_t planeCount() { return piece::count; }
+        std::size_t wordsPerPlane() const { return m_wordsPerPlane; }
+        std::size_t wordsPerEnv() const { return (planeCount() * m_wordsPerPlane); }
+        const std::vector<Word_t> & observations() const { return m_observations; }
+        const Word_t * observation(const std::size_t envIndex) const;
+
+        // the Head plane has the rivals too, so this is the player's cell, or the cell count
+        // if the player has no head right now
+        const std::vector<std::uint32_t> & playerCells() const { return m_playerCells; }
+
+        // score earned during the last step()
+        const std::vector<int> & rewards() const { return m_rewards; }
+
+        // 1 where the last step() ended a game (including timing out) and started another
+        const std::vector<std::uint8_t> & dones() const { return m_dones; }
+
+        // 1 where the player died during the last step(), even in god mode
+        const std::vector<std::uint8_t> & livesLost() const { return m_livesLost; }
+
+        // steps taken by all the environments together since construction
+        std::size_t envStepCount() const { return m_envStepCount; }
+
+        // Takes stepCount steps with random actions (going straight included) and prints how
+        // many env-steps per second that was, to see how fast a bot could be trained.
+        void benchmark(const std::size_t stepCount, const Seed_t seed);
+
+      private:
+        void startEnv(const std::size_t envIndex);
+        void stepEnv(const std::size_t envIndex, const sf::Keyboard::Key action);
+        void observe(const std::size_t envIndex);
+
+      private:
+        GameConfig m_config;
+        Layout m_layout;
+        std::vector<std::unique_ptr<BatchWorld>> m_worlds;
+        Seed_t m_baseSeed;
+        Seed_t m_nextSeed;
+        std::size_t m_wordsPerPlane;
+        std::size_t m_envStepCount;
+
+        std::vector<Word_t> m_observations;
+        std::vector<std::uint32_t> m_playerCells;
+        std::vector<int> m_rewards;
+        std::vector<std::uint8_t> m_dones;
+        std::vector<std::uint8_t> m_livesLost;
+
+        static inline const sf::Vector2u m_defaultResolution{ 1920u, 1080u };
+    };
+} // namespace snake
+
+#endif // SNAKE_VECTOR_ENV_HPP_INCLUDED